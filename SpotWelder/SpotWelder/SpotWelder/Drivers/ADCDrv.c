@@ -0,0 +1,571 @@
+//*****************************************************************************
+//
+// File Name	: 'ADCDrv.c'
+// Title		: Capacitive Discharge spot welder - ADC Acquisition Driver
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+//Notes:
+//The ADC is run from its own interrupt: each conversion complete ISR saves 
+//the sample, moves the MUX to the next channel and starts the next 
+//conversion, so the channels are scanned round robin without the main loop
+//ever waiting on a conversion.  At F_CPU/128 a conversion takes ~113uS, 
+//giving ~2.9k samples per second on each of 3 channels.
+//
+//Every (1 << _ADC_OVERSAMPLE_SHIFT) samples on a channel are summed and 
+//decimated to one _ADC_RESULT_BITS result, which goes into the channel's 
+//ring.  The filtered value is the average of the ring, kept as a running sum.
+//The AREF calibration is applied in fixed point when converting to mV.
+//
+//The energy integrator sums VCAP * ISENSE (Raw samples) once per scan while
+//the weld output is on, and turns the output off right here in the ISR when
+//the target is reached, so an energy terminated pulse ends within one scan 
+//(~0.4mS) of the target instead of on the next weld tick.
+//
+//The misfire check watches every pulse: once per scan while the output is
+//on, ISENSE has to reach the threshold within _ADC_MISFIRE_TIME_US of the
+//output turning on, or the output is cut here and the misfire flagged. 
+//A failed SSR or an open secondary is caught inside the first half cycle.
+//A phase fired (Constant current) output is gated on for only part of each
+//half cycle, so the check runs from the first gate on through the gaps, and
+//the current has to show some time in that first full half cycle.
+//
+//The expulsion detector averages VCAP over windows of conducting scans and
+//compares each window with the one before (Cross multiplied - no division
+//in the ISR).  Expelled metal makes the electrode voltage fall suddenly, so
+//a window that drops by more than 1/(2^_ADC_EXPEL_DROP_SHIFT) cuts the 
+//output right here, and the weld engine ends the pulse on its next tick.
+//The first window of each pulse only sets the reference.
+//
+//The dynamic resistance trace sums VCAP and ISENSE once per scan while the
+//weld is conducting, into a fixed number of time bins.  When the bins are 
+//full, neighbouring pairs are merged and each bin covers twice the time, 
+//so any pulse length fits in the same RAM.  The division to resistance is
+//left for after the weld.
+//
+//ISENSE samples are also summed squared for the constant current control, 
+//which takes the sum every half cycle to get the RMS current.
+//
+//VLINE samples are summed squared the same way, but framed by the zero 
+//cross ISR: every _ADC_LINE_FRAME half cycles the sum is latched, so the 
+//line RMS is always over whole half cycles.  The square root is only taken
+//when someone asks for it, never in an ISR.
+
+//AVR LIB-C includes
+#include <avr/io.h>
+#include <avr/sfr_defs.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+//The header for this driver
+#include "ADCDrv.h"
+//Weld output pin
+#include "GPIO.h"
+
+//Shift to decimate a sum of samples to a result
+#define _ADC_DECIMATE_SHIFT			(_ADC_OVERSAMPLE_SHIFT - (_ADC_RESULT_BITS - 10))
+
+//Local Variables
+static volatile adc_ch_s_t ADC_Data[_ADC_NUM_CH];
+static volatile uint8_t ADC_Channel = 0;
+static uint16_t ADC_AREF_mV = 5000;
+
+//Energy integrator
+static volatile uint8_t ADC_EnergyActive = 0;
+static volatile uint8_t ADC_EnergyReached = 0;
+static volatile uint32_t ADC_EnergySum = 0;
+static uint32_t ADC_EnergyTarget = 0;
+
+//Misfire detection
+static volatile uint8_t ADC_MisfireActive = 0;
+static volatile uint8_t ADC_Misfire = 0;
+static uint8_t ADC_MisfireOn = 0;
+static uint8_t ADC_MisfireSeen = 0;
+static uint8_t ADC_MisfireScans = 0;
+static uint8_t ADC_MisfirePhased = 0;
+static uint16_t ADC_MisfireThreshold = 0;
+
+//Expulsion detection
+static volatile uint8_t ADC_ExpelActive = 0;
+static volatile uint8_t ADC_Expelled = 0;
+static volatile uint8_t ADC_ExpelPending = 0;
+static uint8_t ADC_ExpelOn = 0;
+static uint16_t ADC_ExpelMinI = 0;
+static uint16_t ADC_ExpelSum = 0, ADC_ExpelPrevSum = 0;
+static uint8_t ADC_ExpelCount = 0, ADC_ExpelPrevCount = 0;
+
+//Dynamic resistance trace
+static volatile adc_drbin_s_t ADC_DRTrace[_ADC_DR_BINS];
+static volatile uint8_t ADC_DRActive = 0;
+static volatile uint8_t ADC_DRBin = 0;
+static volatile uint16_t ADC_DRBinScans = 0;
+static uint16_t ADC_DRBinSize = 1;
+static uint16_t ADC_DRMinI = 0;
+
+//Current squared sum
+static volatile uint32_t ADC_CurrentSquares = 0;
+static volatile uint8_t ADC_CurrentCount = 0;
+
+//Line voltage squared sum (Running, and latched at the end of each frame)
+static volatile uint32_t ADC_LineSquares = 0;
+static volatile uint8_t ADC_LineCount = 0;
+static volatile uint8_t ADC_LineHalfCycles = 0;
+static volatile uint32_t ADC_LineFrameSquares = 0;
+static volatile uint8_t ADC_LineFrameCount = 0;
+
+//ADC conversion complete ISR - Save the sample and start the next channel
+ISR(ADC_vect)
+{
+	volatile adc_ch_s_t* Ch = &ADC_Data[ADC_Channel];
+	uint16_t Sample, Result;
+	uint8_t ScanDone, i;
+	
+	Sample = ADC;
+	
+	//Start the next channel right away
+	ScanDone = 0;
+	if(++ADC_Channel >= _ADC_NUM_CH){
+		ADC_Channel = 0;
+		ScanDone = 1;
+	}
+	ADMUX = _ADC_REF_BITS | ADC_Channel;
+	ADCSRA |= _BV(ADSC);
+	
+	//Sum the current squared (Stops if nobody takes it)
+	if( (Ch == &ADC_Data[_ADC_CH_ISENSE]) && (ADC_CurrentCount < 0xff) ){
+		ADC_CurrentSquares += (uint32_t)Sample * Sample;
+		ADC_CurrentCount++;
+	}
+	
+	//Sum the line voltage squared (Framed by the zero cross)
+	if( (Ch == &ADC_Data[_ADC_CH_VLINE]) && (ADC_LineCount < 0xff) ){
+		ADC_LineSquares += (uint32_t)Sample * Sample;
+		ADC_LineCount++;
+	}
+	
+	//Oversample
+	Ch->Last = Sample;
+	Ch->Accum += Sample;
+	if(++Ch->Count >= (1 << _ADC_OVERSAMPLE_SHIFT)){
+		//Decimate and put the result in the ring
+		Result = Ch->Accum >> _ADC_DECIMATE_SHIFT;
+		Ch->Sum -= Ch->Ring[Ch->Index];
+		Ch->Ring[Ch->Index] = Result;
+		Ch->Sum += Result;
+		Ch->Index = (Ch->Index + 1) & (_ADC_RING_LEN - 1);
+		Ch->Accum = 0;
+		Ch->Count = 0;
+	}
+	
+	//Integrate the energy once per scan while the weld is on
+	if(ScanDone && ADC_EnergyActive && (_WELDOUTPINS & _BV(_WELDOUTPIN))){
+		ADC_EnergySum += ((uint32_t)ADC_Data[_ADC_CH_VCAP].Last * ADC_Data[_ADC_CH_ISENSE].Last) >> _ADC_ENERGY_SHIFT;
+		//Target reached - Cut the weld now
+		if(ADC_EnergySum >= ADC_EnergyTarget){
+			_GPIOWeld_OFF;
+			ADC_EnergyReached = 1;
+			ADC_EnergyActive = 0;
+		}
+	}
+	
+	//Check each pulse for current (Phase fired - The first half cycle, gaps and all)
+	if(ScanDone && ADC_MisfireActive){
+		if( (_WELDOUTPINS & _BV(_WELDOUTPIN)) || (ADC_MisfirePhased && ADC_MisfireOn) ){
+			//New pulse - Start the check
+			if(!ADC_MisfireOn){
+				ADC_MisfireOn = 1;
+				ADC_MisfireSeen = 0;
+				ADC_MisfireScans = 0;
+			}
+			if(!ADC_MisfireSeen){
+				if(ADC_Data[_ADC_CH_ISENSE].Last >= ADC_MisfireThreshold){
+					ADC_MisfireSeen = 1;
+				}else if(++ADC_MisfireScans >= _ADC_MISFIRE_SCANS){
+					//No current - Cut the weld now
+					_GPIOWeld_OFF;
+					ADC_Misfire = 1;
+					ADC_MisfireActive = 0;
+				}
+			}
+		}else{
+			ADC_MisfireOn = 0;
+		}
+	}
+	
+	//Watch for a sudden electrode voltage drop
+	if(ScanDone && ADC_ExpelActive){
+		if(_WELDOUTPINS & _BV(_WELDOUTPIN)){
+			//New pulse - Start with no reference window
+			if(!ADC_ExpelOn){
+				ADC_ExpelOn = 1;
+				ADC_ExpelSum = 0;
+				ADC_ExpelCount = 0;
+				ADC_ExpelPrevCount = 0;
+			}
+			if(ADC_Data[_ADC_CH_ISENSE].Last >= ADC_ExpelMinI){
+				ADC_ExpelSum += ADC_Data[_ADC_CH_VCAP].Last;
+				if(++ADC_ExpelCount >= _ADC_EXPEL_WINDOW){
+					//Window done - Compare Sum / Count with the last one
+					if(ADC_ExpelPrevCount){
+						uint32_t Now  = (uint32_t)ADC_ExpelSum * ADC_ExpelPrevCount;
+						uint32_t Prev = (uint32_t)ADC_ExpelPrevSum * ADC_ExpelCount;
+						if(Now < (Prev - (Prev >> _ADC_EXPEL_DROP_SHIFT))){
+							//Expulsion - Cut the weld now
+							_GPIOWeld_OFF;
+							ADC_Expelled = 1;
+							ADC_ExpelPending = 1;
+						}
+					}
+					ADC_ExpelPrevSum = ADC_ExpelSum;
+					ADC_ExpelPrevCount = ADC_ExpelCount;
+					ADC_ExpelSum = 0;
+					ADC_ExpelCount = 0;
+				}
+			}
+		}else{
+			ADC_ExpelOn = 0;
+		}
+	}
+	
+	//Trace the dynamic resistance while conducting
+	if( ScanDone && ADC_DRActive && (_WELDOUTPINS & _BV(_WELDOUTPIN)) &&
+	    (ADC_Data[_ADC_CH_ISENSE].Last >= ADC_DRMinI) ){
+		ADC_DRTrace[ADC_DRBin].V += ADC_Data[_ADC_CH_VCAP].Last;
+		ADC_DRTrace[ADC_DRBin].I += ADC_Data[_ADC_CH_ISENSE].Last;
+		if(++ADC_DRBinScans >= ADC_DRBinSize){
+			ADC_DRBinScans = 0;
+			//Out of bins - Merge pairs and double the bin time
+			if(++ADC_DRBin >= _ADC_DR_BINS){
+				for(i = 0; i < (_ADC_DR_BINS / 2); i++){
+					ADC_DRTrace[i].V = ADC_DRTrace[i << 1].V + ADC_DRTrace[(i << 1) + 1].V;
+					ADC_DRTrace[i].I = ADC_DRTrace[i << 1].I + ADC_DRTrace[(i << 1) + 1].I;
+					ADC_DRTrace[i + (_ADC_DR_BINS / 2)].V = 0;
+					ADC_DRTrace[i + (_ADC_DR_BINS / 2)].I = 0;
+				}
+				ADC_DRBin = _ADC_DR_BINS / 2;
+				ADC_DRBinSize <<= 1;
+			}
+		}
+	}
+}
+
+//ADC Functions
+//Set up and start the scan; AREF_mV is the calibrated reference voltage
+void ADC_Init(uint16_t AREF_mV){
+	
+	uint8_t i, j;
+	
+	ADC_SetAREF(AREF_mV);
+	
+	//Clear the channel data
+	for(i = 0; i < _ADC_NUM_CH; i++){
+		ADC_Data[i].Accum = 0;
+		ADC_Data[i].Count = 0;
+		ADC_Data[i].Index = 0;
+		ADC_Data[i].Sum = 0;
+		ADC_Data[i].Last = 0;
+		for(j = 0; j < _ADC_RING_LEN; j++) ADC_Data[i].Ring[j] = 0;
+	}
+	
+	//Start with the first channel
+	ADC_Channel = 0;
+	ADMUX = _ADC_REF_BITS | ADC_Channel;
+	//Enable, interrupt on complete and start the first conversion
+	ADCSRA = _BV(ADEN) | _BV(ADIE) | _ADC_PS_BITS;
+	ADCSRA |= _BV(ADSC);
+}
+
+//Change the calibrated reference voltage
+void ADC_SetAREF(uint16_t AREF_mV){
+	
+	ADC_AREF_mV = AREF_mV;
+}
+
+//Get the last raw sample of a channel (10 bits)
+uint16_t ADC_GetLast(uint8_t Channel){
+	
+	uint16_t TempVal;
+	
+	if(Channel >= _ADC_NUM_CH) return 0;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = ADC_Data[Channel].Last;
+	}
+	return TempVal;
+}
+
+//Get the filtered value of a channel (_ADC_RESULT_BITS)
+uint16_t ADC_GetFiltered(uint8_t Channel){
+	
+	uint16_t TempVal;
+	
+	if(Channel >= _ADC_NUM_CH) return 0;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = ADC_Data[Channel].Sum;
+	}
+	return (TempVal >> _ADC_RING_SHIFT);
+}
+
+//Get the filtered value of a channel at the pin in mV
+uint16_t ADC_GetMillivolts(uint8_t Channel){
+	
+	return (uint16_t)(((uint32_t)ADC_GetFiltered(Channel) * ADC_AREF_mV) >> _ADC_RESULT_BITS);
+}
+
+//Get the calibrated reference voltage
+uint16_t ADC_GetAREF(void){
+	
+	return ADC_AREF_mV;
+}
+
+//Energy integrator Functions
+//Start integrating VCAP * ISENSE while the weld output is on; the output is cut at Target
+void ADC_StartEnergy(uint32_t Target){
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		ADC_EnergyTarget = Target;
+		ADC_EnergySum = 0;
+		ADC_EnergyReached = 0;
+		ADC_EnergyActive = 1;
+	}
+}
+
+//Stop integrating
+void ADC_StopEnergy(void){
+	
+	ADC_EnergyActive = 0;
+}
+
+//Get the energy integrated so far (Raw units, see _ADC_ENERGY_SHIFT)
+uint32_t ADC_GetEnergy(void){
+	
+	uint32_t TempVal;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = ADC_EnergySum;
+	}
+	return TempVal;
+}
+
+//Check if the energy target was reached
+uint8_t ADC_IsEnergyReached(void){
+	
+	return ADC_EnergyReached;
+}
+
+//Misfire detection Functions
+//Start checking each pulse for current (ISENSE >= Threshold, Raw); the output is cut on a misfire
+//Phased = 1 for a phase fired output (Constant current), checked over the first half cycle
+void ADC_StartMisfire(uint16_t Threshold, uint8_t Phased){
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		ADC_MisfireThreshold = Threshold;
+		ADC_MisfirePhased = Phased;
+		ADC_MisfireOn = 0;
+		ADC_Misfire = 0;
+		ADC_MisfireActive = 1;
+	}
+}
+
+//Stop checking
+void ADC_StopMisfire(void){
+	
+	ADC_MisfireActive = 0;
+}
+
+//Check if a pulse misfired (No current within _ADC_MISFIRE_TIME_US)
+uint8_t ADC_IsMisfire(void){
+	
+	return ADC_Misfire;
+}
+
+//Expulsion detection Functions
+//Start watching the electrode voltage while the output is on and ISENSE >= MinI (Raw); the output is cut on an expulsion
+void ADC_StartExpulsion(uint16_t MinI){
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		ADC_ExpelMinI = MinI;
+		ADC_ExpelOn = 0;
+		ADC_Expelled = 0;
+		ADC_ExpelPending = 0;
+		ADC_ExpelActive = 1;
+	}
+}
+
+//Stop watching
+void ADC_StopExpulsion(void){
+	
+	ADC_ExpelActive = 0;
+}
+
+//Stop watching and forget any expulsion seen
+void ADC_ClearExpulsion(void){
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		ADC_ExpelActive = 0;
+		ADC_Expelled = 0;
+		ADC_ExpelPending = 0;
+	}
+}
+
+//Check if an expulsion was seen since the start
+uint8_t ADC_IsExpelled(void){
+	
+	return ADC_Expelled;
+}
+
+//Check for an expulsion the weld engine has not acted on yet (Clears it)
+uint8_t ADC_TakeExpulsion(void){
+	
+	uint8_t TempVal;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = ADC_ExpelPending;
+		ADC_ExpelPending = 0;
+	}
+	return TempVal;
+}
+
+//Dynamic resistance trace Functions
+//Start tracing VCAP and ISENSE while the output is on and ISENSE >= MinI (Raw)
+void ADC_StartDynR(uint16_t MinI){
+	
+	uint8_t i;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		for(i = 0; i < _ADC_DR_BINS; i++){
+			ADC_DRTrace[i].V = 0;
+			ADC_DRTrace[i].I = 0;
+		}
+		ADC_DRBin = 0;
+		ADC_DRBinScans = 0;
+		ADC_DRBinSize = 1;
+		ADC_DRMinI = MinI;
+		ADC_DRActive = 1;
+	}
+}
+
+//Stop tracing
+void ADC_StopDynR(void){
+	
+	ADC_DRActive = 0;
+}
+
+//Get the number of bins traced (0 to _ADC_DR_BINS)
+uint8_t ADC_GetDynRBins(void){
+	
+	uint8_t TempVal;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = ADC_DRBin;
+		//Part filled last bin counts too
+		if(ADC_DRBinScans) TempVal++;
+	}
+	return TempVal;
+}
+
+//Get a traced bin. Returns 1 if valid, 0 if not
+uint8_t ADC_GetDynRBin(uint8_t Bin, adc_drbin_s_t* Data){
+	
+	if(Bin >= _ADC_DR_BINS) return 0;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		Data->V = ADC_DRTrace[Bin].V;
+		Data->I = ADC_DRTrace[Bin].I;
+	}
+	return (Data->I != 0);
+}
+
+//Current Functions
+//Get the sum of ISENSE samples squared since the last call, and the sample count, then restart
+uint32_t ADC_TakeCurrentSquares(uint8_t* Count){
+	
+	uint32_t TempVal;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = ADC_CurrentSquares;
+		*Count = ADC_CurrentCount;
+		ADC_CurrentSquares = 0;
+		ADC_CurrentCount = 0;
+	}
+	return TempVal;
+}
+
+//Line Voltage Functions
+//Frame the line voltage measurement (Called from the zero cross ISR)
+void ADC_LineZeroX(void){
+	
+	if(++ADC_LineHalfCycles < _ADC_LINE_FRAME) return;
+	
+	//Frame done - Latch it and start the next one
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		ADC_LineFrameSquares = ADC_LineSquares;
+		ADC_LineFrameCount = ADC_LineCount;
+		ADC_LineSquares = 0;
+		ADC_LineCount = 0;
+		ADC_LineHalfCycles = 0;
+	}
+}
+
+//Get the RMS of the VLINE samples over the last complete frame (Raw, 10 bits, 0 = No frame yet)
+uint16_t ADC_GetLineRMS(void){
+	
+	uint32_t Squares;
+	uint8_t Count;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		Squares = ADC_LineFrameSquares;
+		Count = ADC_LineFrameCount;
+	}
+	if(!Count) return 0;
+	
+	return ADC_ISqrt(Squares / Count);
+}
+
+//Integer square root
+uint16_t ADC_ISqrt(uint32_t Val){
+	
+	uint32_t Root = 0, Bit = 1UL << 30;
+	
+	while(Bit > Val) Bit >>= 2;
+	while(Bit){
+		if(Val >= Root + Bit){
+			Val -= Root + Bit;
+			Root = (Root >> 1) + Bit;
+		}else{
+			Root >>= 1;
+		}
+		Bit >>= 2;
+	}
+	return (uint16_t)Root;
+}
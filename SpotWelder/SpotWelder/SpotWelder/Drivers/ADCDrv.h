@@ -0,0 +1,163 @@
+//*****************************************************************************
+//
+// File Name	: 'ADCDrv.h'
+// Title		: Capacitive Discharge spot welder - ADC Acquisition Driver
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+#ifndef ADCDRV_H_
+#define ADCDRV_H_
+
+#include <avr/io.h>
+
+//Channels (ADC MUX inputs, Port A)
+#define _ADC_CH_VCAP				0			//Capacitor bank / weld voltage
+#define _ADC_CH_ISENSE				1			//Weld current sense
+#define _ADC_CH_VLINE				2			//Line voltage sense
+#define _ADC_NUM_CH					3			//Channels scanned (0 to _ADC_NUM_CH - 1)
+
+//Settings
+//Samples summed per result (1 << n) - 16 samples of 10 bits give 12 bit results
+#define _ADC_OVERSAMPLE_SHIFT		4
+#define _ADC_RESULT_BITS			12
+//Results kept per channel for the filtered value (1 << n)
+#define _ADC_RING_SHIFT				3
+#define _ADC_RING_LEN				(1 << _ADC_RING_SHIFT)
+//Reference (External AREF pin) and clock (F_CPU/128 = 115kHz)
+#define _ADC_REF_BITS				0
+#define _ADC_PS_BITS				(_BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0))
+#define _ADC_PRESCALE				128
+//ADC clocks per conversion (13.5 for a single conversion, plus the ISR restart)
+#define _ADC_CLKS_PER_CONV			14
+//Time for one scan of all channels (uS * 10)
+#define _ADC_SCAN_TIME_US_X10		(((_ADC_CLKS_PER_CONV * _ADC_PRESCALE * 1000000UL) / (F_CPU / 10)) * _ADC_NUM_CH)
+//Energy integrator: (VCAP * ISENSE) raw products are summed once per scan, shifted down by this
+#define _ADC_ENERGY_SHIFT			4
+//Line RMS: half cycles (zero crosses) per measurement frame
+#define _ADC_LINE_FRAME				8
+//Misfire: current must show this soon after the output turns on (One 50Hz half cycle)
+#define _ADC_MISFIRE_TIME_US		10000
+#define _ADC_MISFIRE_SCANS			((_ADC_MISFIRE_TIME_US * 10UL) / _ADC_SCAN_TIME_US_X10)
+//Expulsion: electrode voltage is averaged over windows of conducting scans (~20mS, two 50Hz half cycles)
+#define _ADC_EXPEL_WINDOW			((20000 * 10UL) / _ADC_SCAN_TIME_US_X10)
+//Expulsion trips when a window averages (1 >> n) less than the one before (2 = 25%)
+#define _ADC_EXPEL_DROP_SHIFT		2
+//Dynamic resistance trace: bins per weld (Power of 2, bins are merged in pairs as the weld goes on)
+#define _ADC_DR_BINS				32
+
+//Channel data
+typedef struct adc_ch_s_t
+	{
+		uint16_t	Accum;						//Sum of samples for the next result
+		uint8_t		Count;						//Samples in Accum
+		uint8_t		Index;						//Next ring entry to write
+		uint16_t	Ring[_ADC_RING_LEN];		//Last results (_ADC_RESULT_BITS)
+		uint16_t	Sum;						//Sum of the ring
+		uint16_t	Last;						//Last raw sample (10 bits)
+	} adc_ch_s_t;
+
+//Dynamic resistance trace bin
+typedef struct adc_drbin_s_t
+	{
+		uint32_t	V;							//Sum of VCAP samples (Raw)
+		uint32_t	I;							//Sum of ISENSE samples (Raw)
+	} adc_drbin_s_t;
+
+//ADC Functions
+//Set up and start the scan; AREF_mV is the calibrated reference voltage
+void ADC_Init(uint16_t AREF_mV);
+//Change the calibrated reference voltage
+void ADC_SetAREF(uint16_t AREF_mV);
+//Get the last raw sample of a channel (10 bits)
+uint16_t ADC_GetLast(uint8_t Channel);
+//Get the filtered value of a channel (_ADC_RESULT_BITS)
+uint16_t ADC_GetFiltered(uint8_t Channel);
+//Get the filtered value of a channel at the pin in mV
+uint16_t ADC_GetMillivolts(uint8_t Channel);
+//Get the calibrated reference voltage
+uint16_t ADC_GetAREF(void);
+
+//Energy integrator Functions
+//Start integrating VCAP * ISENSE while the weld output is on; the output is cut at Target
+void ADC_StartEnergy(uint32_t Target);
+//Stop integrating
+void ADC_StopEnergy(void);
+//Get the energy integrated so far (Raw units, see _ADC_ENERGY_SHIFT)
+uint32_t ADC_GetEnergy(void);
+//Check if the energy target was reached
+uint8_t ADC_IsEnergyReached(void);
+
+//Misfire detection Functions
+//Start checking each pulse for current (ISENSE >= Threshold, Raw); the output is cut on a misfire
+//Phased = 1 for a phase fired output (Constant current), checked over the first half cycle
+void ADC_StartMisfire(uint16_t Threshold, uint8_t Phased);
+//Stop checking
+void ADC_StopMisfire(void);
+//Check if a pulse misfired (No current within _ADC_MISFIRE_TIME_US)
+uint8_t ADC_IsMisfire(void);
+
+//Expulsion detection Functions
+//Start watching the electrode voltage while the output is on and ISENSE >= MinI (Raw); the output is cut on an expulsion
+void ADC_StartExpulsion(uint16_t MinI);
+//Stop watching
+void ADC_StopExpulsion(void);
+//Stop watching and forget any expulsion seen
+void ADC_ClearExpulsion(void);
+//Check if an expulsion was seen since the start
+uint8_t ADC_IsExpelled(void);
+//Check for an expulsion the weld engine has not acted on yet (Clears it)
+uint8_t ADC_TakeExpulsion(void);
+
+//Dynamic resistance trace Functions
+//Start tracing VCAP and ISENSE while the output is on and ISENSE >= MinI (Raw)
+void ADC_StartDynR(uint16_t MinI);
+//Stop tracing
+void ADC_StopDynR(void);
+//Get the number of bins traced (0 to _ADC_DR_BINS)
+uint8_t ADC_GetDynRBins(void);
+//Get a traced bin. Returns 1 if valid, 0 if not
+uint8_t ADC_GetDynRBin(uint8_t Bin, adc_drbin_s_t* Data);
+
+//Current Functions
+//Get the sum of ISENSE samples squared since the last call, and the sample count, then restart
+uint32_t ADC_TakeCurrentSquares(uint8_t* Count);
+
+//Line Voltage Functions
+//Frame the line voltage measurement (Called from the zero cross ISR)
+void ADC_LineZeroX(void);
+//Get the RMS of the VLINE samples over the last complete frame (Raw, 10 bits, 0 = No frame yet)
+uint16_t ADC_GetLineRMS(void);
+
+//Integer square root
+uint16_t ADC_ISqrt(uint32_t Val);
+
+#endif /* ADCDRV_H_ */
@@ -0,0 +1,257 @@
+//*****************************************************************************
+//
+// File Name	: 'EEQueue.c'
+// Title		: Capacitive Discharge spot welder - Asynchronous EEPROM Writer
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+//Notes:
+//EEPROM writes take ~3.4mS per byte, and the avr-libc eeprom_update_xxx()
+//routines busy wait for every byte.  This writer queues the writes instead, 
+//and commits them one byte at a time from the EE_READY interrupt, so saving
+//settings costs no time in the main loop.  Bytes that already hold the 
+//requested value are skipped, same as eeprom_update_xxx().
+//
+//Writes to the same location that are still waiting in the queue are merged,
+//so only the latest value is written.  Block writes are queued by reference
+//and the data is read from SRAM when each byte is committed.
+
+//AVR LIB-C includes
+#include <avr/io.h>
+#include <avr/sfr_defs.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+#include <util/atomic.h>
+
+//The header for this driver
+#include "EEQueue.h"
+
+//Maximum unchanged bytes to check per interrupt before letting other ISRs run
+#define _EEQ_MAX_SKIP				8
+
+//Working Variables
+static eeq_entry_s_t Queue[_EEQ_QUEUE_LEN];
+static volatile uint8_t Head;						//Entry being written
+static volatile uint8_t HeadPos;					//Next byte of the head entry
+static volatile uint8_t Count;						//Entries in queue
+
+//Private functions 
+//Commit the next byte in the queue - EEPROM must not be busy!
+//Returns 0 if queue is empty, 1 if a write was started, 2 if nothing needed writing yet
+static uint8_t EEQ_WriteNext(void);
+static uint8_t EEQ_WriteNext(void){
+	
+	eeq_entry_s_t* Entry;
+	uint8_t Data;
+	uint8_t Checked = 0;
+	
+	while(Count){
+		Entry = &Queue[Head];
+		//Get the data for this byte
+		if(Entry->Src)
+			Data = Entry->Src[HeadPos];
+		else
+			Data = Entry->Value[HeadPos];
+		//Set the address 
+		EEAR = Entry->Addr + HeadPos;
+		//Advance to next byte, remove the entry if done
+		if(++HeadPos >= Entry->Len){
+			HeadPos = 0;
+			if(++Head >= _EEQ_QUEUE_LEN) Head = 0;
+			Count--;
+		}
+		//Read the current value
+		EECR |= _BV(EERE);
+		//Only write if different
+		if(EEDR != Data){
+			EEDR = Data;
+			//Start the write (Erase + Write)
+			EECR |= _BV(EEMPE);
+			EECR |= _BV(EEPE);
+			return 1;
+		}
+		//Don't hog the CPU if lots of bytes are unchanged
+		if(++Checked >= _EEQ_MAX_SKIP) return 2;
+	}
+	
+	return 0;
+}
+
+//Let the queue move on by at least one byte check.  With interrupts on the 
+//EE_READY interrupt does the writing; before sei() it is done here
+static void EEQ_WaitWrite(void);
+static void EEQ_WaitWrite(void){
+	
+	if(SREG & _BV(SREG_I)){
+		EECR |= _BV(EERIE);
+	}else{
+		loop_until_bit_is_clear(EECR, EEPE);
+		EEQ_WriteNext();
+	}
+}
+
+//Add a write to the queue
+static void EEQ_Queue(uint16_t Addr, const uint8_t* Src, const uint8_t* Value, uint8_t Len);
+static void EEQ_Queue(uint16_t Addr, const uint8_t* Src, const uint8_t* Value, uint8_t Len){
+	
+	eeq_entry_s_t* Entry = 0;
+	uint8_t i, Index;
+	
+	//Queue full? Wait for room with interrupts on (Only the writer takes entries 
+	//out, so there is still room once inside the atomic block below)
+	while(Count >= _EEQ_QUEUE_LEN) EEQ_WaitWrite();
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		//Look for a waiting write to the same location
+		for(i = 0; i < Count; i++){
+			Index = Head + i;
+			if(Index >= _EEQ_QUEUE_LEN) Index -= _EEQ_QUEUE_LEN;
+			//Skip the entry being written if it was started 
+			if((i == 0) && (HeadPos != 0)) continue;
+			if((Queue[Index].Addr == Addr) && (Queue[Index].Len == Len) &&
+			   (Queue[Index].Src == Src) ){
+				Entry = &Queue[Index];
+				break;
+			}
+		}
+		//Not found - add a new one
+		if(!Entry){
+			Index = Head + Count;
+			if(Index >= _EEQ_QUEUE_LEN) Index -= _EEQ_QUEUE_LEN;
+			Entry = &Queue[Index];
+			Entry->Addr = Addr;
+			Entry->Src = Src;
+			Entry->Len = Len;
+			Count++;
+		}
+		//Copy in the data for small writes
+		if(!Src){
+			for(i = 0; i < Len; i++) Entry->Value[i] = Value[i];
+		}
+		//Make sure the writer is running
+		EECR |= _BV(EERIE);
+	}
+}
+
+//Interrupt Handlers	**********
+//EEPROM Ready - Commit the next byte
+ISR(EE_READY_vect){
+	//Stop the interrupt when there is nothing left
+	if(!EEQ_WriteNext()) EECR &= ~_BV(EERIE);
+}
+
+//Writer Functions		**********
+//Initialize the writer - queue is empty and EE_READY interrupt disabled
+void EEQ_Init(void){
+	
+	EECR &= ~_BV(EERIE);
+	Head = HeadPos = Count = 0;
+}
+
+//Queue a byte to be written to EEPROM (only written if different)
+void EEQ_UpdateByte(uint8_t* Addr, uint8_t Value){
+	
+	EEQ_Queue((uint16_t)Addr, 0, &Value, sizeof(Value));
+}
+
+//Queue a word to be written to EEPROM (only written if different)
+void EEQ_UpdateWord(uint16_t* Addr, uint16_t Value){
+	
+	EEQ_Queue((uint16_t)Addr, 0, (const uint8_t*)&Value, sizeof(Value));
+}
+
+//Queue a double word to be written to EEPROM (only written if different)
+void EEQ_UpdateDWord(uint32_t* Addr, uint32_t Value){
+	
+	EEQ_Queue((uint16_t)Addr, 0, (const uint8_t*)&Value, sizeof(Value));
+}
+
+//Queue a block of SRAM to be written to EEPROM - Src must stay valid until written!
+void EEQ_UpdateBlock(const void* Src, void* Addr, uint8_t Len){
+	
+	if(!Len) return;
+	//Small blocks are copied, so Src can go away
+	if(Len <= _EEQ_INLINE_BYTES)
+		EEQ_Queue((uint16_t)Addr, 0, (const uint8_t*)Src, Len);
+	else
+		EEQ_Queue((uint16_t)Addr, (const uint8_t*)Src, 0, Len);
+}
+
+//Write out everything in the queue now (waits until done, interrupts stay on)
+void EEQ_Flush(void){
+	
+	//Wait until empty
+	while(Count) EEQ_WaitWrite();
+	//Wait for the last write to finish
+	loop_until_bit_is_clear(EECR, EEPE);
+}
+
+//Get the number of writes still waiting in the queue
+uint8_t EEQ_Pending(void){
+	
+	return Count;
+}
+
+//Check if a block write from Src is still waiting in the queue (Src must stay put while it is)
+uint8_t EEQ_IsQueued(const void* Src){
+	
+	uint8_t i, Index, Found = 0;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		for(i = 0; i < Count; i++){
+			Index = Head + i;
+			if(Index >= _EEQ_QUEUE_LEN) Index -= _EEQ_QUEUE_LEN;
+			if(Queue[Index].Src == (const uint8_t*)Src){
+				Found = 1;
+				break;
+			}
+		}
+	}
+	return Found;
+}
+
+//Read a block from EEPROM without disturbing a write in progress
+void EEQ_ReadBlock(void* Dst, const void* Addr, uint8_t Len){
+	
+	//Hold off the writer
+	EECR &= ~_BV(EERIE);
+	//Wait for any write in progress
+	eeprom_busy_wait();
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		//Make sure nothing was started in the meantime
+		eeprom_busy_wait();
+		//Read the data
+		eeprom_read_block(Dst, Addr, Len);
+		//Let the writer continue
+		if(Count) EECR |= _BV(EERIE);
+	}
+}
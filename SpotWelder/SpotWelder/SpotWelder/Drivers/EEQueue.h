@@ -0,0 +1,77 @@
+//*****************************************************************************
+//
+// File Name	: 'EEQueue.h'
+// Title		: Capacitive Discharge spot welder - Asynchronous EEPROM Writer
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+#ifndef EEQUEUE_H_
+#define EEQUEUE_H_
+
+#include <avr/io.h>
+
+//Settings
+//Number of pending writes that can be queued before a write blocks
+#define _EEQ_QUEUE_LEN				24
+//Largest value that is copied into the queue (bigger writes are queued by reference)
+#define _EEQ_INLINE_BYTES			4
+
+//Queue entry - one pending write to EEPROM
+typedef struct eeq_entry_s_t
+	{
+		uint16_t		Addr;						//EEPROM destination address
+		const uint8_t*	Src;						//SRAM source for block writes (0 = use Value)
+		uint8_t			Len;						//Number of bytes to write
+		uint8_t			Value[_EEQ_INLINE_BYTES];	//Copy of the data for small writes
+	} eeq_entry_s_t;
+
+//Writer Functions
+//Initialize the writer - queue is empty and EE_READY interrupt disabled
+void EEQ_Init(void);
+//Queue a byte to be written to EEPROM (only written if different)
+void EEQ_UpdateByte(uint8_t* Addr, uint8_t Value);
+//Queue a word to be written to EEPROM (only written if different)
+void EEQ_UpdateWord(uint16_t* Addr, uint16_t Value);
+//Queue a double word to be written to EEPROM (only written if different)
+void EEQ_UpdateDWord(uint32_t* Addr, uint32_t Value);
+//Queue a block of SRAM to be written to EEPROM - Src must stay valid until written!
+void EEQ_UpdateBlock(const void* Src, void* Addr, uint8_t Len);
+//Write out everything in the queue now (waits until done, interrupts stay on)
+void EEQ_Flush(void);
+//Get the number of writes still waiting in the queue
+uint8_t EEQ_Pending(void);
+//Check if a block write from Src is still waiting in the queue (Src must stay put while it is)
+uint8_t EEQ_IsQueued(const void* Src);
+//Read a block from EEPROM without disturbing a write in progress
+void EEQ_ReadBlock(void* Dst, const void* Addr, uint8_t Len);
+
+#endif /* EEQUEUE_H_ */
@@ -75,7 +75,7 @@
 #define _ZCINPORT		PORTD
 #define _ZCINDDR		DDRD
 #define _ZCINPINS		PIND
-//Terminal Connect Sense Input 
+//Terminal Connect Sense Input (INT2, or AIN0 - Analog comparator + with _CONTACT_ACIC)
 #define _CSINPIN		2
 #define _CSINPORT		PORTB
 #define _CSINDDR		DDRB
@@ -86,6 +86,30 @@
 #define _MRELAYOUTDDR	DDRD
 #define _MRELAYOUTPINS	PIND
 
+//Contact sense on the on-chip analog comparator (AIN0 = PB2 sense, AIN1 = PB3 threshold DAC),
+//timestamped by Timer 1 input capture.  Needs the board rework described in README.md: PB3 
+//cut from the DAC /LDAC and wired to the DAC output, /LDAC tied to /CS.
+//Leave undefined for the stock board (INT2 on the external contact sense comparator)
+//#define _CONTACT_ACIC
+
+//PD5 drives either the capacitor charger enable or the electrode force solenoid, never both.
+//Define if the force solenoid is fitted - Capacitor Discharge is then not available
+//#define _FORCE_SOLENOID_FITTED
+
+#if defined( _FORCE_SOLENOID_FITTED )
+//Electrode Force Solenoid Output
+#define _FORCEOUTPIN	5
+#define _FORCEOUTPORT	PORTD
+#define _FORCEOUTDDR	DDRD
+#define _FORCEOUTPINS	PIND
+#else
+//Capacitor Charger Enable Output
+#define _CHARGEOUTPIN	5
+#define _CHARGEOUTPORT	PORTD
+#define _CHARGEOUTDDR	DDRD
+#define _CHARGEOUTPINS	PIND
+#endif
+
 //Port control Macros *********************************************************
 //Weld Control
 #define _GPIOWeld_OFF	(_WELDOUTPORT &= ~_BV(_WELDOUTPIN))
@@ -99,6 +123,23 @@
 #define _MRELAY_OFF		(_MRELAYOUTPORT &= ~_BV(_MRELAYOUTPIN))
 #define _MRELAY_ON		(_MRELAYOUTPORT |=  _BV(_MRELAYOUTPIN))
 #define _MRELAY_TGL		(_MRELAYOUTPINS |=  _BV(_MRELAYOUTPIN))
+#if defined( _FORCE_SOLENOID_FITTED )
+//Electrode Force Solenoid
+#define _FORCE_OFF		(_FORCEOUTPORT &= ~_BV(_FORCEOUTPIN))
+#define _FORCE_ON		(_FORCEOUTPORT |=  _BV(_FORCEOUTPIN))
+#else
+//Capacitor Charger (No force solenoid - The force macros do nothing)
+#define _CHARGE_OFF		(_CHARGEOUTPORT &= ~_BV(_CHARGEOUTPIN))
+#define _CHARGE_ON		(_CHARGEOUTPORT |=  _BV(_CHARGEOUTPIN))
+#define _FORCE_OFF		((void)0)
+#define _FORCE_ON		((void)0)
+#endif
+//Terminal Sense - Contact is made when the electrode voltage is below the threshold DAC 
+#if defined( _CONTACT_ACIC )
+#define _CONTACT_MADE	(!(ACSR & _BV(ACO)))
+#else
+#define _CONTACT_MADE	(_CSINPINS & _BV(_CSINPIN))
+#endif
 
 //GPIO Functions **************************************************************
 //Initialize GPIO
@@ -121,9 +162,15 @@ static inline void GPIO_Init(void){
 	_FSWINDDR  &= ~(_BV(_FSWINPIN));
 	_FSWINPORT |=  (_BV(_FSWINPIN));
 	
+#if defined( _CONTACT_ACIC )
+	//Set CSIN to input, no Pull-up (Analog comparator input)
+	_CSINDDR  &= ~(_BV(_CSINPIN));
+	_CSINPORT &= ~(_BV(_CSINPIN)); 
+#else
 	//Set CSIN to input with Pull-ups 
 	_CSINDDR  &= ~(_BV(_CSINPIN));
 	_CSINPORT |= (_BV(_CSINPIN)); 
+#endif
 		
 	//Set WELD_OUT to output
 	_WELDOUTPORT &= ~_BV(_WELDOUTPIN);
@@ -136,9 +183,19 @@ static inline void GPIO_Init(void){
 	//Set Relay out to output
 	_MRELAYOUTPORT &= ~_BV(_MRELAYOUTPIN);
 	_MRELAYOUTDDR  |=  _BV(_MRELAYOUTPIN); 
+	
+#if defined( _FORCE_SOLENOID_FITTED )
+	//Set Force solenoid out to output (Off)
+	_FORCEOUTPORT &= ~_BV(_FORCEOUTPIN);
+	_FORCEOUTDDR  |=  _BV(_FORCEOUTPIN);
+#else
+	//Set Charger out to output (Off)
+	_CHARGEOUTPORT &= ~_BV(_CHARGEOUTPIN);
+	_CHARGEOUTDDR  |=  _BV(_CHARGEOUTPIN);
+#endif
 		
 	//Disable digital IO port on ADC0-2
 	//to allow ADC to be used
-	DIDR0 |= 0x3;
+	DIDR0 |= 0x7;
 }
 #endif /* GPIO_H_ */
\ No newline at end of file
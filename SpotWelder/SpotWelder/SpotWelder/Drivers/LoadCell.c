@@ -0,0 +1,104 @@
+//*****************************************************************************
+//
+// File Name	: 'LoadCell.c'
+// Title		: Capacitive Discharge spot welder - HX711 Load Cell Driver
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+//Notes:
+//The HX711 (RATE pin high) converts at 80 samples/S and pulls DOUT low when
+//a result is ready.  If PD_SCK is held high for over 60uS the HX711 powers
+//down, so each clock high pulse is atomic; an interrupt can only stretch the
+//low time, and LC_Read runs from the main loop with interrupts on.  While the
+//serial port is sending, TXD owns the clock pin and holds it high, so the 
+//HX711 powers down and reads are skipped until it is released.
+
+//AVR LIB-C includes
+#include <avr/io.h>
+#include <avr/sfr_defs.h>
+#include <util/delay.h>
+#include <util/atomic.h>
+
+//The header for this driver
+#include "LoadCell.h"
+#include "Serial.h"
+
+//Load Cell Functions
+//Set up the load cell interface pins
+void LC_Init(void){
+	
+	//Clock low (Powered up), data in with pull-up
+	_LC_SCK_LOW;
+	_LC_SCK_DDR   |=  _BV(_LC_SCK_BIT);
+	_LC_DOUT_DDR  &= ~_BV(_LC_DOUT_BIT);
+	_LC_DOUT_PORT |=  _BV(_LC_DOUT_BIT);
+}
+
+//Read a conversion if one is ready.  Returns 1 with the signed result, 0 if not ready
+uint8_t LC_Read(int32_t* Result){
+	
+	uint32_t Data = 0;
+	uint8_t i, Bit;
+	
+	//Serial port has the clock pin, or no conversion ready yet
+	if(_SER_TX_ON) return 0;
+	if(_LC_DOUT) return 0;
+	
+	//24 data bits, MSB first - valid after each rising edge
+	for(i = 0; i < 24; i++){
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+			_LC_SCK_HIGH;
+			_delay_us(1);
+			Bit = _LC_DOUT;
+			_LC_SCK_LOW;
+		}
+		Data <<= 1;
+		if(Bit) Data |= 1;
+		_delay_us(1);
+	}
+	
+	//Select the channel and gain of the next conversion
+	for(i = 0; i < _LC_GAIN_PULSES; i++){
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+			_LC_SCK_HIGH;
+			_delay_us(1);
+			_LC_SCK_LOW;
+		}
+		_delay_us(1);
+	}
+	
+	//Sign extend the 24 bit two's complement result
+	if(Data & 0x800000UL) Data |= 0xFF000000UL;
+	*Result = (int32_t)Data;
+	
+	return 1;
+}
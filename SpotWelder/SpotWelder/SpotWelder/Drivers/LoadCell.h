@@ -0,0 +1,68 @@
+//*****************************************************************************
+//
+// File Name	: 'LoadCell.h'
+// Title		: Capacitive Discharge spot welder - HX711 Load Cell Driver
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+
+#ifndef LOADCELL_H_
+#define LOADCELL_H_
+
+#include <avr/io.h>
+
+//Pin configuration (HX711 DOUT on RXD, PD_SCK on TXD - The clock is shared with the serial port)
+#define _LC_DOUT_BIT		0
+#define _LC_DOUT_PORT		PORTD
+#define _LC_DOUT_DDR		DDRD
+#define _LC_DOUT_PINS		PIND
+
+#define _LC_SCK_BIT			1
+#define _LC_SCK_PORT		PORTD
+#define _LC_SCK_DDR			DDRD
+
+//Settings
+//Clock pulses after the 24 data bits, sets the next conversion (1 = Channel A, gain 128)
+#define _LC_GAIN_PULSES		1
+
+//Convenience Macros
+#define _LC_SCK_HIGH		( _LC_SCK_PORT |=  _BV(_LC_SCK_BIT) )
+#define _LC_SCK_LOW			( _LC_SCK_PORT &= ~_BV(_LC_SCK_BIT) )
+#define _LC_DOUT			( _LC_DOUT_PINS & _BV(_LC_DOUT_BIT) )
+
+//Load Cell Functions
+//Set up the load cell interface pins
+void LC_Init(void);
+//Read a conversion if one is ready.  Returns 1 with the signed result, 0 if not ready (Interrupts may be on)
+uint8_t LC_Read(int32_t* Result);
+
+#endif /* LOADCELL_H_ */
@@ -40,6 +40,7 @@
 
 #include <avr/io.h>
 #include "SPI_AVR8_Fixed.h"
+#include "GPIO.h"
 
 //#warning MCP48XX.h assumes that SPI_INIT() has already been called before MCP48_Init()!
 
@@ -50,7 +51,10 @@
 //The following defines if there is a separate /LDAC pin to use when loading values; 
 //comment out if using the configuration described below!
 
+//PB3 is /LDAC on the stock board; with _CONTACT_ACIC (GPIO.h) it is AIN1 and /LDAC is tied to /CS
+#if !defined( _CONTACT_ACIC )
 #define _MCP48_USE_LDAC
+#endif
 
 /* NOTE: /LDAC may be tied to /CS through an inverter to free up an IO pin, and new
    DAC values will be loaded auto-magically when the part is deselected!	   */
@@ -0,0 +1,107 @@
+//*****************************************************************************
+//
+// File Name	: 'Serial.c'
+// Title		: Capacitive Discharge spot welder - Serial (USART0) Transmit Driver
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+//Notes:
+//Transmit only, polled: the serial port is only used to dump diagnostics
+//from the menus, where the time spent waiting on the transmitter does not 
+//matter, so there is no buffer or interrupt to share with the weld ISRs.
+//TXD is also the load cell clock; the transmitter is turned on by the first
+//character and SER_Release hands the pin back when a dump is done.
+
+//AVR LIB-C includes
+#include <avr/io.h>
+#include <avr/sfr_defs.h>
+#include <avr/pgmspace.h>
+
+//The header for this driver
+#include "Serial.h"
+
+//Serial Functions
+//Set up USART0 for transmit only (8N1, TXD = PD1); the transmitter stays off until used
+void SER_Init(void){
+	
+	UBRR0 = _SER_UBRR;
+	UCSR0A = 0;
+	UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+	UCSR0B = 0;
+}
+
+//Send a character (Waits for room in the transmitter)
+void SER_PutChar(char Data){
+	
+	UCSR0B |= _BV(TXEN0);
+	while(!(UCSR0A & _BV(UDRE0)));
+	//Clear the transmit complete flag for SER_Release
+	UCSR0A = _BV(TXC0);
+	UDR0 = Data;
+}
+
+//Wait for the last character to go, then turn the transmitter off (Frees TXD)
+void SER_Release(void){
+	
+	if(!_SER_TX_ON) return;
+	while(!(UCSR0A & _BV(TXC0)));
+	UCSR0B &= ~_BV(TXEN0);
+}
+
+//Send a string from program memory
+void SER_PutStr_P(const char* Str){
+	
+	char c;
+	
+	while( (c = pgm_read_byte(Str++)) ) SER_PutChar(c);
+}
+
+//Send a number in decimal
+void SER_PutNumber(uint32_t Val){
+	
+	char Digits[10];
+	uint8_t i = 0;
+	
+	do{
+		Digits[i++] = '0' + (Val % 10);
+		Val /= 10;
+	}while(Val);
+	
+	while(i) SER_PutChar(Digits[--i]);
+}
+
+//Send a line end (CR LF)
+void SER_NewLine(void){
+	
+	SER_PutChar('\r');
+	SER_PutChar('\n');
+}
@@ -0,0 +1,65 @@
+//*****************************************************************************
+//
+// File Name	: 'Serial.h'
+// Title		: Capacitive Discharge spot welder - Serial (USART0) Transmit Driver
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+#ifndef SERIAL_H_
+#define SERIAL_H_
+
+#include <avr/io.h>
+
+//Settings
+//Baud rate (115200 is exact from 14.7456 MHz)
+#define _SER_BAUD					115200UL
+#define _SER_UBRR					((F_CPU / (16UL * _SER_BAUD)) - 1)
+
+//Convenience Macros
+//Transmitter on - TXD (The load cell clock) belongs to the serial port
+#define _SER_TX_ON					(UCSR0B & _BV(TXEN0))
+
+//Serial Functions
+//Set up USART0 for transmit only (8N1, TXD = PD1); the transmitter stays off until used
+void SER_Init(void);
+//Send a character (Waits for room in the transmitter)
+void SER_PutChar(char Data);
+//Wait for the last character to go, then turn the transmitter off (Frees TXD)
+void SER_Release(void);
+//Send a string from program memory
+void SER_PutStr_P(const char* Str);
+//Send a number in decimal
+void SER_PutNumber(uint32_t Val);
+//Send a line end (CR LF)
+void SER_NewLine(void);
+
+#endif /* SERIAL_H_ */
@@ -53,6 +53,16 @@ static volatile weldenabled_enum_t SysWeldEnabler;
 static volatile uint16_t NextToggle;
 static volatile weldcycle_s_t ActiveWeldCycle; 
 static volatile uint16_t WeldTicks;
+static volatile uint32_t WeldFireUS;
+
+//Constant current control Variables
+static volatile uint8_t PhaseActive = 0;
+static volatile uint8_t PhaseConduction;
+static volatile uint16_t PhaseTargetA;
+static volatile uint16_t PhaseCurrentA;
+static int32_t PhaseIntegral;
+static uint32_t PhaseLastZeroX;
+static uint8_t PhaseHalfCycle = 144;
 
 static systimeractive_enum_t SysTimerActive;
 static uint8_t BeepActive = 0;
@@ -64,6 +74,9 @@ ISR(TIMER0_COMPA_vect )
 {
 	SysTicks++;													//Increment System tick counter
 	
+	WELD_ChargeTick();											//Regulate the capacitor bank charge
+	WELD_FootSwitchTick();										//Debounce the foot switch
+	
 	if (BeepActive){
 		if((SysTicks - BeepStart) > BeepTime){
 			BeepActive = 0;
@@ -76,10 +89,40 @@ ISR(TIMER0_COMPA_vect )
 //Weld Cycle Timer (Timer 1 Compare match B interrupt)
 ISR(TIMER1_COMPA_vect )
 {
+	//Energy target reached? End the pulse now 
+	if( (ActiveWeldCycle.Type == WeldType_Energy) &&
+	    (ActiveWeldCycle.Stage == WeldStage_Pulse0) &&
+		ADC_IsEnergyReached() ) NextToggle = WeldTicks;
+	//Expulsion? The output is already off - End the weld now (No second pulse)
+	if( ((ActiveWeldCycle.Stage == WeldStage_Pulse0) || (ActiveWeldCycle.Stage == WeldStage_Pulse1)) &&
+	    ADC_TakeExpulsion() ){
+		if(ActiveWeldCycle.Type == WeldType_Double) ActiveWeldCycle.Stage = WeldStage_Pulse1;
+		NextToggle = WeldTicks;
+	}
+	//Misfire? The output is already off - End the cycle
+	if( (SysWeldEnabler == Weld_Enabled) && ADC_IsMisfire() ){
+		StopPhaseControl();
+		_GPIOWeld_OFF;
+		SysWeldEnabler = Weld_NotEnabled;
+		_FORCE_OFF;
+		ActiveWeldCycle.Stage = WeldStage_End;
+		TRACE_Event(TrcEvt_WeldStage, WeldStage_End);
+	}
 	//Time to cycle state machine?
 	if(WeldTicks++ == NextToggle){ 
 		if(SysWeldEnabler == Weld_Enabled) SetNextWeldState();										//Set proper state in weld state machine
 	}
+	//Took longer than a weld tick?
+	if(TIFR1 & _BV(OCF1A)) TRACE_Overrun(_TRACE_OVR_WELDTMR);
+}
+
+//Phase angle Timer (Timer 2 compare match A interrupt) - Firing delay is up
+ISR(TIMER2_COMPA_vect )
+{
+	//Fire for the rest of the half cycle
+	if(PhaseActive) _GPIOWeld_ON;
+	//One shot
+	_StopPhaseTimer;
 }
 
 //Initialize and configure both timers; does not start them!
@@ -103,6 +146,13 @@ void InitializeTimers(void)
 	TCCR0A = _BV(WGM01);										//Set CTC Mode
 	TIFR0 |= _BV(OCIE0A);										//Ensure interrupt flag is clear
 	TIMSK0 = _BV(OCIE0A);										//Enable Timer0 Compare Match A interrupt
+	
+	//Timer 2
+	_StopPhaseTimer;											//Make sure timer is stopped
+	TCNT2  = 0;													//Clear Timer2 count
+	TCCR2A = _BV(WGM21);										//Set CTC Mode
+	TIFR2  = _BV(OCF2A);										//Ensure interrupt flag is clear
+	TIMSK2 = _BV(OCIE2A);										//Enable Timer2 Compare Match A interrupt
 }
 
 //Start up the system Timer (Timer 0)  Gives 10ms Counts in SysTimer
@@ -126,6 +176,25 @@ uint32_t GetSysTicks(void){
 	return SysTicks;
 }
 
+//Get the time since the system timer started in uS (~70uS resolution)
+uint32_t GetSysMicros(void){
+	
+	uint32_t Ticks;
+	uint8_t Counts;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		Ticks = SysTicks;
+		Counts = TCNT0;
+		//Tick due but not counted yet? 
+		if(TIFR0 & _BV(OCF0A)){
+			Counts = TCNT0;
+			Ticks++;
+		}
+	}
+	//Timer 0 counts are 625/9 uS each (144 counts per 10mS tick)
+	return (Ticks * (_MS_PER_SYSTICK * 1000UL)) + (((uint32_t)Counts * 625) / 9);
+}
+
 //Start the beeper
 void Beep(uint32_t timeMS){
 	
@@ -146,15 +215,29 @@ void StartWeldCycle(weldcycle_s_t * NewWeldCycle)
 	{	
 		//Set weld cycle type
 		ActiveWeldCycle.Type = NewWeldCycle->Type;
+		ActiveWeldCycle.Current = NewWeldCycle->Current;
 		//If there is no active weld cycle, continue
 		//Calculate actual timer values from mS values given
 		//Default 1 tick delay before cycle start must be included in calculation as offset
+		//End of squeeze
+		ActiveWeldCycle.Squeeze_Ticks = (NewWeldCycle->Squeeze_Ticks / _MS_PER_WELDTICK);
 		//End of pulse 0
-		ActiveWeldCycle.Pulse_0_Ticks =  (NewWeldCycle->Pulse_0_Ticks / _MS_PER_WELDTICK);
+		ActiveWeldCycle.Pulse_0_Ticks =  ((NewWeldCycle->Squeeze_Ticks + NewWeldCycle->Pulse_0_Ticks) / _MS_PER_WELDTICK);
 		//End of Inter-pulse Delay
-		ActiveWeldCycle.Delay_0_Ticks = ((NewWeldCycle->Pulse_0_Ticks + NewWeldCycle->Delay_0_Ticks) / _MS_PER_WELDTICK );
+		ActiveWeldCycle.Delay_0_Ticks = ((NewWeldCycle->Squeeze_Ticks + NewWeldCycle->Pulse_0_Ticks + NewWeldCycle->Delay_0_Ticks) / _MS_PER_WELDTICK );
 		//End of pulse 1
-		ActiveWeldCycle.Pulse_1_Ticks = ((NewWeldCycle->Pulse_0_Ticks + NewWeldCycle->Delay_0_Ticks + NewWeldCycle->Pulse_1_Ticks) / _MS_PER_WELDTICK );					
+		ActiveWeldCycle.Pulse_1_Ticks = ((NewWeldCycle->Squeeze_Ticks + NewWeldCycle->Pulse_0_Ticks + NewWeldCycle->Delay_0_Ticks + NewWeldCycle->Pulse_1_Ticks) / _MS_PER_WELDTICK );					
+		//Length of the hold (From the end of the last pulse - Energy can end it early)
+		ActiveWeldCycle.Hold_Ticks = (NewWeldCycle->Hold_Ticks / _MS_PER_WELDTICK);
+		
+		//Each boundary at least one tick after the one before (A boundary that has 
+		//already passed would not be seen until WeldTicks wraps - Output stuck on)
+		if(ActiveWeldCycle.Pulse_0_Ticks <= ActiveWeldCycle.Squeeze_Ticks)
+			ActiveWeldCycle.Pulse_0_Ticks = ActiveWeldCycle.Squeeze_Ticks + 1;
+		if(ActiveWeldCycle.Delay_0_Ticks <= ActiveWeldCycle.Pulse_0_Ticks)
+			ActiveWeldCycle.Delay_0_Ticks = ActiveWeldCycle.Pulse_0_Ticks + 1;
+		if(ActiveWeldCycle.Pulse_1_Ticks <= ActiveWeldCycle.Delay_0_Ticks)
+			ActiveWeldCycle.Pulse_1_Ticks = ActiveWeldCycle.Delay_0_Ticks + 1;
 		
 		//ActiveWeldCycle contains actual count values at this point instead of mS Values
 		NextToggle = 0;	
@@ -176,14 +259,28 @@ void SetNextWeldState(void)
 	
 	//Get the current Tick Value 
 	EntryTime = WeldTicks;
+	
+	//Squeeze - Close the electrodes, the first pulse starts when the squeeze time is up
+	if( (ActiveWeldCycle.Stage == WeldStage_Wait) && ActiveWeldCycle.Squeeze_Ticks ){
+		_FORCE_ON;
+		NextToggle = ActiveWeldCycle.Squeeze_Ticks;
+		ActiveWeldCycle.Stage = WeldStage_Squeeze;
+		TRACE_Event(TrcEvt_WeldStage, WeldStage_Squeeze);
+		return;
+	}
 			
 	if(ActiveWeldCycle.Type == WeldType_Double)
 	{
 		switch(ActiveWeldCycle.Stage)
 		{
 			case WeldStage_Wait:
+			case WeldStage_Squeeze:
 				//Wait for Zero-x
-				if( WaitZeroX() ) _GPIOWeld_ON;
+				if( WaitZeroX() ){
+					_GPIOWeld_ON;
+					//Save time of first pulse
+					WeldFireUS = GetSysMicros();
+				}
 				//Compute the Weld offset
 				WeldOffSet += WeldTicks - EntryTime;
 				//Set Next Toggle Time 
@@ -213,7 +310,15 @@ void SetNextWeldState(void)
 				break;
 			
 			case WeldStage_Pulse1:
-			
+				//Hold - Weld off, the force stays on while the weld cools (WeldTicks has already moved on)
+				if(ActiveWeldCycle.Hold_Ticks){
+					_GPIOWeld_OFF;
+					_FORCE_ON;			//Already on if there was a squeeze
+					NextToggle = EntryTime - 1 + ActiveWeldCycle.Hold_Ticks;
+					ActiveWeldCycle.Stage = WeldStage_Hold;
+					break;
+				}
+			case WeldStage_Hold:
 			default:
 				NextToggle = 0xFFFF;
 				//Turn Off Weld 
@@ -226,13 +331,25 @@ void SetNextWeldState(void)
 		}	
 	}
 	
-	if(ActiveWeldCycle.Type == WeldType_Single)
+	if( (ActiveWeldCycle.Type == WeldType_Single) || 
+	    (ActiveWeldCycle.Type == WeldType_CapDischarge) ||
+		(ActiveWeldCycle.Type == WeldType_Energy) ||
+		(ActiveWeldCycle.Type == WeldType_ConstCurrent) )
 	{
 		switch(ActiveWeldCycle.Stage)
 		{
 			case WeldStage_Wait:
-				//Wait for Zero-x
-				if( WaitZeroX() ) _GPIOWeld_ON;
+			case WeldStage_Squeeze:
+				//Wait for Zero-x (Not for a capacitor discharge)
+				if( (ActiveWeldCycle.Type == WeldType_CapDischarge) || WaitZeroX() ){
+					//Constant current fires from the zero cross ISR
+					if(ActiveWeldCycle.Type == WeldType_ConstCurrent)
+						StartPhaseControl(ActiveWeldCycle.Current);
+					else
+						_GPIOWeld_ON;
+					//Save time of first pulse
+					WeldFireUS = GetSysMicros();
+				}
 				//Compute the Weld offset
 				WeldOffSet += WeldTicks - EntryTime;
 				//Set Next Toggle Time 
@@ -243,10 +360,20 @@ void SetNextWeldState(void)
 				break;
 				
 			case WeldStage_Pulse0:
-			
+				//Hold - Weld off, the force stays on while the weld cools (WeldTicks has already moved on)
+				if(ActiveWeldCycle.Hold_Ticks){
+					StopPhaseControl();
+					_GPIOWeld_OFF;
+					_FORCE_ON;			//Already on if there was a squeeze
+					NextToggle = EntryTime - 1 + ActiveWeldCycle.Hold_Ticks;
+					ActiveWeldCycle.Stage = WeldStage_Hold;
+					break;
+				}
+			case WeldStage_Hold:
 			default:
 				NextToggle = 0xFFFF;
 				//Turn Off Weld 
+				StopPhaseControl();
 				_GPIOWeld_OFF;
 				//Set Next stage
 				ActiveWeldCycle.Stage = WeldStage_Wait;
@@ -259,10 +386,14 @@ void SetNextWeldState(void)
 	if(SysWeldEnabler == Weld_NotEnabled)						//If for any reason, WeldEnabler = Weld_NotEnabled (safety, error, finished, etc)
 	{
 		_GPIOWeld_OFF;											//Ensure weld output is OFF!
+		_FORCE_OFF;												//Open the electrodes
 		ActiveWeldCycle.Stage = WeldStage_End;					//Set wait mode (Weld was halted for some reason, or is finished)
 		//Clear Offset
 		WeldOffSet = 0;
 	}
+	
+	//Trace the new stage
+	TRACE_Event(TrcEvt_WeldStage, ActiveWeldCycle.Stage);
 }
 
 //Set the current Weld State
@@ -274,6 +405,7 @@ int SetActiveWeldState (weldcycle_enum_t stage){
 	   (ActiveWeldCycle.Stage == WeldStage_End)    ){
 		//If not, set state
 		if(IsWeldEnabled()) {
+			if(ActiveWeldCycle.Stage != stage) TRACE_Event(TrcEvt_WeldStage, stage);
 			ActiveWeldCycle.Stage = stage;
 			return (1);
 		}else{
@@ -291,6 +423,25 @@ weldcycle_enum_t GetActiveWeldState(void){
 	return ActiveWeldCycle.Stage;
 }
 
+//Get the system time (uS) when the first pulse of the last weld started
+uint32_t GetWeldFireMicros(void){
+	
+	uint32_t TempVal;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = WeldFireUS;
+	}
+	return TempVal;
+}
+
+//Run the weld timer on the next count instead of the next weld tick (Starts a new cycle now)
+void WeldTimerTickNow(void){
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TCNT1 = OCR1A - 1;
+	}
+}
+
 //Emergency Halt a weld if in progress
 void EmergencyHaltWeld(void){
 	//Disable in progress welds 
@@ -299,7 +450,108 @@ void EmergencyHaltWeld(void){
 	ActiveWeldCycle.Stage = WeldStage_End;
 	//Stop the timer 
 	_StopWeldTimer;
+	//Stop any phase angle firing
+	StopPhaseControl();
 	//Turn off the output (If On)
 	_GPIOWeld_OFF;	
+	//Open the electrodes (If closed)
+	_FORCE_OFF;
+	//Trace it
+	TRACE_Event(TrcEvt_WeldStage, WeldStage_End);
+}
+
+//Constant Current Routines
+//Start firing each half cycle at the angle needed for TargetA
+void StartPhaseControl(uint16_t TargetA){
+	
+	uint8_t Count;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		PhaseTargetA = TargetA;
+		PhaseConduction = _CC_START_CONDUCTION;
+		PhaseIntegral = (int32_t)_CC_START_CONDUCTION << 8;
+		PhaseCurrentA = 0;
+		//Gate stays off until the first zero cross
+		_GPIOWeld_OFF;
+		ADC_TakeCurrentSquares(&Count);
+		PhaseActive = 1;
+	}
 }
 
+//Stop firing (Output off)
+void StopPhaseControl(void){
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		PhaseActive = 0;
+		_StopPhaseTimer;
+	}
+}
+
+//Run the current controller and schedule the next firing (Called from the zero cross ISR)
+void PhaseControlZeroX(void){
+	
+	uint32_t Now, Squares, Rms;
+	uint8_t Count, Delay;
+	int32_t Error, Out;
+	
+	//Half cycle length (Timer 2 counts)
+	Now = GetSysMicros();
+	if( ((Now - PhaseLastZeroX) > _CC_MIN_HALFCYCLE_US) && 
+	    ((Now - PhaseLastZeroX) < _CC_MAX_HALFCYCLE_US) )
+		PhaseHalfCycle = (uint8_t)(((Now - PhaseLastZeroX) * 9) / _US_PER_TMR2_COUNT_X9);
+	PhaseLastZeroX = Now;
+	
+	if(!PhaseActive) return;
+	
+	//Misfire or expulsion cut the output - Keep it off until the pulse is ended
+	if(ADC_IsMisfire() || ADC_IsExpelled()){
+		_StopPhaseTimer;
+		_GPIOWeld_OFF;
+		return;
+	}
+	
+	//Gate off until the firing angle
+	_StopPhaseTimer;
+	_GPIOWeld_OFF;
+	
+	//RMS current of the half cycle that just ended (A)
+	Squares = ADC_TakeCurrentSquares(&Count);
+	if(Count){
+		Rms = ADC_ISqrt(Squares / Count);
+		Rms = ((Rms * ADC_GetAREF()) >> 10) * _ISENSE_A_PER_V / 1000;
+		PhaseCurrentA = (uint16_t)Rms;
+		
+		//PI - Conduction (0-255) from the current error
+		Error = (int32_t)PhaseTargetA - (int32_t)PhaseCurrentA;
+		//Integral (Q8) is held to the conduction range (Anti-windup)
+		PhaseIntegral += Error * _CC_KI_Q8;
+		if(PhaseIntegral > ((int32_t)_CC_MAX_CONDUCTION << 8)) PhaseIntegral = (int32_t)_CC_MAX_CONDUCTION << 8;
+		if(PhaseIntegral < 0) PhaseIntegral = 0;
+		Out = ((Error * _CC_KP_Q8) + PhaseIntegral) >> 8;
+		if(Out < _CC_MIN_CONDUCTION) Out = _CC_MIN_CONDUCTION;
+		if(Out > _CC_MAX_CONDUCTION) Out = _CC_MAX_CONDUCTION;
+		PhaseConduction = (uint8_t)Out;
+	}
+	
+	//Schedule the firing (Delay = rest of the half cycle after conduction)
+	Delay = (uint8_t)(((uint16_t)(_CC_MAX_CONDUCTION - PhaseConduction) * PhaseHalfCycle) >> 8);
+	if(!Delay){
+		_GPIOWeld_ON;
+	}else{
+		TCNT2 = 0;
+		OCR2A = Delay;
+		TIFR2 = _BV(OCF2A);
+		_StartPhaseTimer;
+	}
+}
+
+//Get the RMS current of the last half cycle (A)
+uint16_t GetPhaseCurrent(void){
+	
+	uint16_t TempVal;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = PhaseCurrentA;
+	}
+	return TempVal;
+}
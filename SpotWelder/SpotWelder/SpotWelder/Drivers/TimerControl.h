@@ -44,6 +44,17 @@
 #define _MS_PER_SYSTICK				10
 #define _TMR1_COUNTS_PER_TICK		720		//Timer 1 counts: 720 counts ~ 50 mS @ 14.7456 mHz ps = 1024 
 #define _MS_PER_WELDTICK			50
+#define _US_PER_TMR1_COUNT_X9		625		//Timer 1 counts are 625/9 uS @ 14.7456 mHz ps = 1024 
+#define _US_PER_TMR2_COUNT_X9		625		//Timer 2 counts are 625/9 uS @ 14.7456 mHz ps = 1024 
+
+//Constant current (Phase angle) control
+#define _CC_START_CONDUCTION		128		//First half cycle conduction (0-255 = 0-100%)
+#define _CC_MIN_CONDUCTION			16		//Never fire later than this (Leaves time to latch before the zero cross)
+#define _CC_MAX_CONDUCTION			255
+#define _CC_KP_Q8					64		//Proportional gain (Conduction per A, Q8)
+#define _CC_KI_Q8					32		//Integral gain (Conduction per A per half cycle, Q8)
+#define _CC_MIN_HALFCYCLE_US		7000	//Valid half cycle range (50 or 60 Hz)
+#define _CC_MAX_HALFCYCLE_US		12000
 
 //Timer control macros
 //Weld timer
@@ -52,6 +63,9 @@
 //System Timer
 #define _StartSystemTimer			TCCR0B = _BV(CS02) | (1 <<CS00)
 #define _StopSystemTimer			TCCR0B = ~(_BV(CS02) | _BV(CS00))
+//Phase angle (Firing delay) timer
+#define _StartPhaseTimer			TCCR2B = _BV(CS22) | _BV(CS21) | _BV(CS20)
+#define _StopPhaseTimer				TCCR2B = 0
 
 //Custom Types/ enums
 typedef enum systimeractive_enum_t
@@ -74,13 +88,18 @@ typedef enum weldcycle_enum_t
 		WeldStage_Delay,
 		WeldStage_Pulse1,
 		WeldStage_Run,
-		WeldStage_End
+		WeldStage_End,
+		WeldStage_Squeeze,						//Force solenoid on, waiting for the electrodes to close
+		WeldStage_Hold							//Weld off, force kept on while the weld cools
 	} weldcycle_enum_t;
 //Weld Type Enum (Single or Dual Pulse)
 typedef enum weldtype_enum_t
 	{
 		WeldType_Single = 1,
 		WeldType_Double	= 2,
+		WeldType_CapDischarge = 3,				//Single pulse from the capacitor bank, not synced to the line
+		WeldType_Energy = 4,					//Single pulse, ended early when the energy target is reached
+		WeldType_ConstCurrent = 5				//Single pulse, phase angle controlled to hold a current
 	} weldtype_enum_t;
 
 //Struct to hold all data about a weld cycle	
@@ -89,6 +108,9 @@ typedef struct weldcycle_s_t
 		uint16_t Pulse_0_Ticks;
 		uint16_t Pulse_1_Ticks;
 		uint16_t Delay_0_Ticks;
+		uint16_t Current;						//Target RMS current (A) for constant current
+		uint16_t Squeeze_Ticks;					//Force on before the first pulse (0 = No force solenoid)
+		uint16_t Hold_Ticks;					//Force kept on after the last pulse
 		weldcycle_enum_t Stage;
 		weldtype_enum_t Type;					
 	} weldcycle_s_t;
@@ -101,6 +123,8 @@ void StartSystemTimer(void);
 void StopSystemTimer(void);
 //Get the system Tick Count
 uint32_t GetSysTicks(void);
+//Get the time since the system timer started in uS (~70uS resolution)
+uint32_t GetSysMicros(void);
 
 //Utility routines 
 //Run the beeper
@@ -115,7 +139,21 @@ void SetNextWeldState(void);
 int SetActiveWeldState (weldcycle_enum_t stage);
 //Get the current Weld State
 weldcycle_enum_t GetActiveWeldState(void);
+//Get the system time (uS) when the first pulse of the last weld started
+uint32_t GetWeldFireMicros(void);
+//Run the weld timer on the next count instead of the next weld tick (Starts a new cycle now)
+void WeldTimerTickNow(void);
 //Emergency Halt a weld if in progress
 void EmergencyHaltWeld(void);
 
+//Constant Current Routines
+//Start firing each half cycle at the angle needed for TargetA
+void StartPhaseControl(uint16_t TargetA);
+//Stop firing (Output off)
+void StopPhaseControl(void);
+//Run the current controller and schedule the next firing (Called from the zero cross ISR)
+void PhaseControlZeroX(void);
+//Get the RMS current of the last half cycle (A)
+uint16_t GetPhaseCurrent(void);
+
 #endif /* TIMERCONTROL_H_ */
\ No newline at end of file
@@ -0,0 +1,200 @@
+//*****************************************************************************
+//
+// File Name	: 'ProbeID.c'
+// Title		: Probe identification and per probe settings
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+//Notes:
+//Each probe lead carries an ID resistor across its sense terminals, which 
+//pulls the open electrode voltage down into a band above the contact range.
+//There is no spare ADC input, so the open voltage is read with the sense 
+//comparator and threshold DAC (WELD_SenseSAR()) while the measurement relay 
+//is closed.  A reading below the lowest band means the probes are touching,
+//and is ignored.
+//
+//Every probe ID has its own copy of the weld settings and trigger threshold
+//in EEPROM.  When a different probe is seen, the settings in use are saved 
+//to the old probe's slot and the new probe's slot is loaded (A probe that 
+//has not been seen before keeps the settings in use).  The trigger threshold
+//is then kept below the new probe's ID band, so its open voltage can not 
+//read as contact.
+
+#include "SpotWelder.h"
+
+//Per probe settings (As stored in EEPROM)
+typedef struct probeslot_s_t
+{
+	weldctrl_s_t Settings;			//Weld settings
+	uint8_t  TrigLevel;				//Contact trigger threshold (Threshold DAC code)
+	uint8_t  Saved;					//_PROBE_SLOT_SAVED once written
+} probeslot_s_t;
+
+#define _PROBE_SLOT_SAVED			0x5A
+
+//Reference to Global Weld Settings 
+extern weldctrl_s_t WeldSettings;
+//Reference to DAC Setting 
+extern uint8_t ContactTrigLevel;
+
+//EEPROM data and Variables
+probeslot_s_t EEMEM ee_PROBE_SLOT[_PROBE_IDS];				//Settings for each probe
+uint8_t		  EEMEM ee_PROBE_ID = 0;						//Probe the settings in use belong to
+
+//Probe Local Variables *******************************************************
+static uint8_t ProbeID;										//Probe the settings in use belong to
+static uint8_t LastCode;									//Last open reading
+static uint8_t PendingID, PendingCount;						//New ID waiting to be confirmed
+static uint32_t LastCheck;									//Time of the last read (System ticks)
+
+//Each probe's last saved slot - Queued to the EEPROM writer by reference, so 
+//a slot's copy stays put until the next swap away from that probe
+static probeslot_s_t SlotSave[_PROBE_IDS];
+
+//Function implementations ****************************************************
+
+//Convert an open reading to a probe ID (_PROBE_NONE if the probes are touching)
+static uint8_t CodeToID(uint8_t Code);
+static uint8_t CodeToID(uint8_t Code){
+	
+	if(Code >= _PROBE_ID0_CODE) return 0;
+	if(Code < (_PROBE_ID0_CODE - ((_PROBE_IDS - 1) * _PROBE_BAND_CODES))) return _PROBE_NONE;
+	return ((_PROBE_ID0_CODE - 1 - Code) / _PROBE_BAND_CODES) + 1;
+}
+
+//Save the settings in use for the old probe and load the new probe's settings
+static void SwitchProbe(uint8_t ID);
+static void SwitchProbe(uint8_t ID){
+	
+	probeslot_s_t* Slot;
+	
+	//Save the old probe's slot (The writer drains it in the background)
+	Slot = &SlotSave[ProbeID];
+	Slot->Settings = WeldSettings;
+	Slot->TrigLevel = ContactTrigLevel;
+	Slot->Saved = _PROBE_SLOT_SAVED;
+	EEQ_UpdateBlock(Slot, &ee_PROBE_SLOT[ProbeID], sizeof(probeslot_s_t));
+	
+	//Load the new probe's slot (if it has one) - A copy saved since power up
+	//is the newest, and may still be waiting for the writer
+	Slot = &SlotSave[ID];
+	if(Slot->Saved != _PROBE_SLOT_SAVED)
+		EEQ_ReadBlock(Slot, &ee_PROBE_SLOT[ID], sizeof(probeslot_s_t));
+	if(Slot->Saved == _PROBE_SLOT_SAVED){
+		WeldSettings = Slot->Settings;
+		ContactTrigLevel = Slot->TrigLevel;
+		//The slot may hold a type or trigger this welder can't use
+		ValidateSettings();
+	}
+	
+	//Keep the threshold below the ID band
+	ProbeID = ID;
+	if(ContactTrigLevel > PROBE_GetMaxTrigLevel()) ContactTrigLevel = PROBE_GetMaxTrigLevel();
+	MCP48_SetValue((uint16_t)ContactTrigLevel, _MCP48_GAIN_2);
+	
+	EEQ_UpdateByte(&ee_PROBE_ID, ProbeID);
+	SaveSettings();
+	
+	TRACE_Event(TrcEvt_Probe, ProbeID);
+}
+
+//Probe Functions *********
+//Read the fitted probe at power up and load its settings (Needs interrupts on)
+void PROBE_Init(void){
+	
+	uint8_t ID;
+	
+	//Interrupts are on - Read around the EEPROM writer
+	EEQ_ReadBlock(&ProbeID, &ee_PROBE_ID, sizeof(ProbeID));
+	if(ProbeID >= _PROBE_IDS) ProbeID = 0;
+	PendingID = _PROBE_NONE;
+	PendingCount = 0;
+	LastCheck = GetSysTicks();
+	
+	//Connect the sense circuit and read the ID
+	WELD_SetMRelay(1);
+	while(WELD_GetMRelay() != MRelay_Closed);
+	LastCode = WELD_SenseSAR();
+	WELD_SetMRelay(0);
+	
+	//Swapped while the power was off?
+	ID = CodeToID(LastCode);
+	if( (ID != _PROBE_NONE) && (ID != ProbeID) ) SwitchProbe(ID);
+}
+
+//Check for a probe swap (Call while waiting for contact, measurement relay closed)
+void PROBE_Service(void){
+	
+	uint8_t ID;
+	
+	if((GetSysTicks() - LastCheck) < (_PROBE_CHECK_MS / _MS_PER_SYSTICK)) return;
+	//Never over a touch, or an edge the trigger has not seen yet
+	if(!WELD_IsContactIdle()) return;
+	LastCheck = GetSysTicks();
+	
+	LastCode = WELD_SenseSAR();
+	ID = CodeToID(LastCode);
+	
+	//Touching, or the same probe
+	if( (ID == _PROBE_NONE) || (ID == ProbeID) ){
+		PendingCount = 0;
+		return;
+	}
+	
+	//A new ID has to read the same a few times (Not a touch on the way down)
+	if(ID != PendingID){
+		PendingID = ID;
+		PendingCount = 0;
+	}
+	if(++PendingCount >= _PROBE_CONFIRM){
+		PendingCount = 0;
+		SwitchProbe(ID);
+		//Let the operator know the settings changed
+		UI_ForceUpdate();
+		Beep(200);
+	}
+}
+
+//Get the ID of the fitted probe
+uint8_t PROBE_GetID(void){
+	return ProbeID;
+}
+
+//Get the highest trigger threshold for the fitted probe (Threshold DAC code, below its ID band)
+uint8_t PROBE_GetMaxTrigLevel(void){
+	return (_PROBE_ID0_CODE - (ProbeID * _PROBE_BAND_CODES) - _PROBE_TRIG_MARGIN);
+}
+
+//Get the last open reading (Threshold DAC code)
+uint8_t PROBE_GetLastCode(void){
+	return LastCode;
+}
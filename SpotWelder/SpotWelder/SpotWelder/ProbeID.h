@@ -0,0 +1,63 @@
+//*****************************************************************************
+//
+// File Name	: 'ProbeID.h'
+// Title		: Probe identification and per probe settings
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+#ifndef PROBEID_H_
+#define PROBEID_H_
+
+#include <avr/io.h>
+
+//Probe ID settings
+#define _PROBE_IDS					4			//Probe types (ID 0 = No ID resistor)
+#define _PROBE_ID0_CODE				240			//Open reading at or above this is ID 0 (Threshold DAC code)
+#define _PROBE_BAND_CODES			12			//Width of each ID band below ID 0 (Threshold DAC steps)
+#define _PROBE_TRIG_MARGIN			8			//Keep the trigger threshold this far below the ID band
+#define _PROBE_CHECK_MS				250			//Time between ID reads while waiting for contact
+#define _PROBE_CONFIRM				3			//Matching reads needed to accept a new ID
+#define _PROBE_NONE					0xFF		//No valid read (Probes touching)
+
+//Probe Functions *********
+//Read the fitted probe at power up and load its settings (Needs interrupts on)
+void PROBE_Init(void);
+//Check for a probe swap (Call while waiting for contact, measurement relay closed)
+void PROBE_Service(void);
+//Get the ID of the fitted probe
+uint8_t PROBE_GetID(void);
+//Get the highest trigger threshold for the fitted probe (Threshold DAC code, below its ID band)
+uint8_t PROBE_GetMaxTrigLevel(void);
+//Get the last open reading (Threshold DAC code)
+uint8_t PROBE_GetLastCode(void);
+
+#endif /* PROBEID_H_ */
@@ -34,6 +34,8 @@
 //  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //*****************************************************************************
 
+#include <stddef.h>
+
 #include "SpotWelder.h"
 
 //Variables
@@ -55,6 +57,10 @@ extern uint8_t ContactTrigLevel;
 
 //Locally visible 
 static uint16_t AREF_Calibrated;
+//Warm restart state - Not cleared on reset!
+static warmstate_s_t WarmState __attribute__ ((section (".noinit")));
+static uint8_t WarmRestart = 0;
+static uint8_t WarmSaved = 0;										//WarmState has been written since the reset
 //static uint16_t AREF_Offset;
 
 //EEPROM data and Variables
@@ -74,6 +80,20 @@ uint16_t	EEMEM ee_AREF_CAL		;			//Calibrated AREF
 //DAC Setting (Trigger threshold)
 uint8_t		EEMEM ee_DAC_Setting	= 200;		//DAC Setting
 
+//Energy terminated weld target (Non-Volatile)
+uint16_t	EEMEM ee_WELD_ENERGY_J	 = 100;		//Weld Energy in J
+
+//Constant current weld target (Non-Volatile)
+uint16_t	EEMEM ee_WELD_CURRENT_A	 = 300;		//Weld Current in A
+
+//Force trigger setpoint (Non-Volatile)
+uint16_t	EEMEM ee_WELD_FORCE_N	 = 50;		//Electrode Force in N
+
+//Squeeze, Hold and Off times (Non-Volatile)
+uint16_t	EEMEM ee_WELD_SQUEEZE	 = 0;		//Squeeze Time (mS)
+uint16_t	EEMEM ee_WELD_HOLD		 = 0;		//Hold Time (mS)
+uint16_t	EEMEM ee_WELD_OFF		 = 0;		//Off Time (mS, 0 = No repeat)
+
 //Load settings from EEPROM to SRAM
 void LoadSettings(void){
 	
@@ -84,6 +104,21 @@ void LoadSettings(void){
 		WeldSettings.Voltage = TempVal;
 	else
 		WeldSettings.Voltage = _WeldDef_Voltage;
+//Load Energy Target
+	if ( (TempVal = eeprom_read_word(&ee_WELD_ENERGY_J)) != 0xffff) 
+		WeldSettings.Energy = TempVal;
+	else
+		WeldSettings.Energy = _WeldDef_Energy;
+//Load Current Target
+	if ( (TempVal = eeprom_read_word(&ee_WELD_CURRENT_A)) != 0xffff) 
+		WeldSettings.Current = TempVal;
+	else
+		WeldSettings.Current = _WeldDef_Current;
+//Load Force Setpoint
+	if ( (TempVal = eeprom_read_word(&ee_WELD_FORCE_N)) != 0xffff) 
+		WeldSettings.Force = TempVal;
+	else
+		WeldSettings.Force = _WeldDef_Force;
 //Load Pulse 0 Length
 	if ( (TempVal = eeprom_read_word(&ee_WELD_P0_LENGTH)) != 0xffff)
 		WeldSettings.P0_Length = TempVal;
@@ -104,25 +139,35 @@ void LoadSettings(void){
 		WeldSettings.Trig_Delay = TempVal;
 	else
 		WeldSettings.Trig_Delay = _WeldDef_TrigDel;
+//Load Squeeze Time
+	if ( (TempVal = eeprom_read_word(&ee_WELD_SQUEEZE)) != 0xffff)
+		WeldSettings.Squeeze_Time = TempVal;
+	else
+		WeldSettings.Squeeze_Time = _WeldDef_Squeeze;
+//Load Hold Time
+	if ( (TempVal = eeprom_read_word(&ee_WELD_HOLD)) != 0xffff)
+		WeldSettings.Hold_Time = TempVal;
+	else
+		WeldSettings.Hold_Time = _WeldDef_Hold;
+//Load Off Time
+	if ( (TempVal = eeprom_read_word(&ee_WELD_OFF)) != 0xffff)
+		WeldSettings.Off_Time = TempVal;
+	else
+		WeldSettings.Off_Time = _WeldDef_Off;
 //Load Trigger Type			
 	if ( (TempVal = eeprom_read_word(&ee_WELD_TRIGGER)) != 0xffff)
 		WeldSettings.Trigger = (weldtrigger_e_t)TempVal;
 	else
 		WeldSettings.Trigger = (weldtrigger_e_t)_WeldDef_Trig;
 //Load Weld Type
-	if ( (TempVal = eeprom_read_word(&ee_WELD_TYPE)) != 0xffff){
+	if ( (TempVal = eeprom_read_word(&ee_WELD_TYPE)) != 0xffff)
 		WeldSettings.Type = (weldtype_e_t)TempVal;
-		//Check Type to see if we need to 'Fix' the trigger
-		if(WeldSettings.Type == wTypeContinuous){
-			//check if trigger is set to foot switch
-			if(WeldSettings.Trigger != wTrigFootSwitch){
-				//Fix it if not
-				WeldSettings.Trigger = wTrigFootSwitch;
-				eeprom_update_word(&ee_WELD_TRIGGER, (uint16_t)wTrigFootSwitch);	
-			}
-		}
-	}else{
+	else
 		WeldSettings.Type = (weldtype_e_t)_WeldDef_Type;
+//'Fix' the type and trigger if they can't be used
+	if(ValidateSettings()){
+		EEQ_UpdateWord(&ee_WELD_TRIGGER, (uint16_t)WeldSettings.Trigger);
+		EEQ_UpdateWord(&ee_WELD_TYPE, (uint16_t)WeldSettings.Type);
 	}
 //Load Cal Value	
 	if ( (TempVal = eeprom_read_word(&ee_AREF_CAL)) != 0xffff)
@@ -137,45 +182,162 @@ void LoadSettings(void){
 	
 }
 
+//Fix weld settings this welder can't use (Stored by older firmware, another 
+//build or a probe slot).  Returns 1 if anything was changed
+uint8_t ValidateSettings(void){
+	
+	uint8_t Fixed = 0;
+	
+	//Unknown type
+	if(WeldSettings.Type > wTypeConstCurrent){
+		WeldSettings.Type = (weldtype_e_t)_WeldDef_Type;
+		Fixed = 1;
+	}
+#if defined( _FORCE_SOLENOID_FITTED )
+	//No charger fitted - Capacitor Discharge is not available
+	if(WeldSettings.Type == wTypeCapDischarge){
+		WeldSettings.Type = (weldtype_e_t)_WeldDef_Type;
+		Fixed = 1;
+	}
+#endif
+	//Unknown trigger
+	if(WeldSettings.Trigger > wTrigStitch){
+		WeldSettings.Trigger = (weldtrigger_e_t)_WeldDef_Trig;
+		Fixed = 1;
+	}
+	//Continuous only runs from the foot switch
+	if( (WeldSettings.Type == wTypeContinuous) && (WeldSettings.Trigger != wTrigFootSwitch) ){
+		WeldSettings.Trigger = wTrigFootSwitch;
+		Fixed = 1;
+	}
+	
+	return Fixed;
+}
+
+//Queue all settings to be written to EEPROM
+void SaveSettings(void){
+	
+	//Only changed bytes are written (In the background)
+	EEQ_UpdateWord(&ee_WELD_VOLTAGE_MV, WeldSettings.Voltage);
+	EEQ_UpdateWord(&ee_WELD_ENERGY_J, WeldSettings.Energy);
+	EEQ_UpdateWord(&ee_WELD_CURRENT_A, WeldSettings.Current);
+	EEQ_UpdateWord(&ee_WELD_FORCE_N, WeldSettings.Force);
+	EEQ_UpdateWord(&ee_WELD_P0_LENGTH, WeldSettings.P0_Length);
+	EEQ_UpdateWord(&ee_WELD_P1_LENGTH, WeldSettings.P1_Length);
+	EEQ_UpdateWord(&ee_WELD_IP_DELAY, WeldSettings.IP_Delay);
+	EEQ_UpdateWord(&ee_WELD_TRIG_DELAY, WeldSettings.Trig_Delay);
+	EEQ_UpdateWord(&ee_WELD_SQUEEZE, WeldSettings.Squeeze_Time);
+	EEQ_UpdateWord(&ee_WELD_HOLD, WeldSettings.Hold_Time);
+	EEQ_UpdateWord(&ee_WELD_OFF, WeldSettings.Off_Time);
+	EEQ_UpdateWord(&ee_WELD_TRIGGER, (uint16_t)WeldSettings.Trigger);
+	EEQ_UpdateWord(&ee_WELD_TYPE, (uint16_t)WeldSettings.Type);
+	EEQ_UpdateByte(&ee_DAC_Setting, ContactTrigLevel);
+}
+
+//Get the CRC of the warm restart state
+static uint16_t WarmStateCRC(void);
+static uint16_t WarmStateCRC(void){
+	
+	uint16_t CRC = 0xffff;
+	uint8_t* Data = (uint8_t*)&WarmState;
+	uint8_t i;
+	
+	for(i = 0; i < offsetof(warmstate_s_t, CRC); i++) CRC = _crc16_update(CRC, Data[i]);
+	
+	return CRC;
+}
+
+//Update the warm restart state (Call from the main loop).  Only rewritten 
+//when the settings, the calibration or the active menu have changed
+void SaveWarmState(void){
+	
+	UIObjHandle Menu = uiObj_GetActive();
+	
+	if( WarmSaved && (WarmState.Menu == Menu) && (WarmState.AREF_Cal == AREF_Calibrated) && 
+		(WarmState.TrigLevel == ContactTrigLevel) && 
+		!memcmp((const void*)&WarmState.Settings, (const void*)&WeldSettings, sizeof(weldctrl_s_t)) ) return;
+	
+	WarmState.Settings = WeldSettings;
+	WarmState.AREF_Cal = AREF_Calibrated;
+	WarmState.TrigLevel = ContactTrigLevel;
+	WarmState.Menu = Menu;
+	WarmState.CRC = WarmStateCRC();
+	WarmSaved = 1;
+}
+
+//Restore the state from before a reset. Returns 1 if restored, 0 if not 
+uint8_t RestoreWarmState(void){
+	
+	//Not after a power on (SRAM is garbage)
+	if(TRACE_GetResetCause() & _BV(PORF)) return 0;
+	//Check it
+	if(WarmState.CRC != WarmStateCRC()) return 0;
+	
+	WeldSettings = WarmState.Settings;
+	AREF_Calibrated = WarmState.AREF_Cal;
+	ContactTrigLevel = WarmState.TrigLevel;
+	
+	return 1;
+}
+
+//Weld critical hardware first, then the UI (The VFD wake up is slow)
 void InitializeHardware(void)
 {
+	//Initialize GPIO (Weld output off)
+	GPIO_Init();
+	//Initialize Serial (Diagnostics output)
+	SER_Init();
+	//Initialize the Load Cell (Shares TXD with the serial port)
+	LC_Init();
 	//Initialize SPI
 	SPI_Init(_SPI_SPEED_FCPU_DIV_2 | _SPI_ORDER_MSB_FIRST | _SPI_SCK_LEAD_FALLING | _SPI_SAMPLE_TRAILING | _SPI_MODE_MASTER);
 	//Initialize Timers
 	InitializeTimers();
-	//Initialize UI System
-	UI_Init();
-	//Initialize VFD Display
-	vfdInit();
-	//Initialize GPIO
-	GPIO_Init();
-	//Start System Timer
+	//Start System Timer (Boot time is measured from here)
 	StartSystemTimer();
-	//Load Settings from EEPROM
-	LoadSettings();
+	//Initialize EEPROM Writer
+	EEQ_Init();
+	//Save the trace from before the reset (if any)
+	TRACE_Init();
+	//Restore the settings from before a reset, or load them from EEPROM
+	WarmRestart = RestoreWarmState();
+	if(WarmRestart){
+		//The last changes may not have been written before the reset
+		SaveSettings();
+	}else{
+		LoadSettings();
+	}
+	//Start the ADC scan (Uses the AREF calibration)
+	ADC_Init(AREF_Calibrated);
+	//Load the Weld Log and Counters
+	WLOG_Init();
 	//Initialize DAC
 	MCP48_Init();
-	//Build the Menu Tree
-	uiHelper_LoadMenus();
 	//Initialize Weld System
 	WELD_Init();
+	//Enable Interrupts (Keeps the system ticks running through the UI init)
+	sei();
+	//Identify the probe and load its settings (Times the measurement relay)
+	PROBE_Init();
+	//Initialize UI System
+	UI_Init();
+	//Build the Menu Tree
+	uiHelper_LoadMenus();
+	//Skip the title screen after a warm restart - Go back to the same menu (Or Home)
+	if(WarmRestart){
+		if(uiObj_Activate(WarmState.Menu) < 0) uiObj_Activate(_uiObjHomeHandle);
+	}
+	//Initialize VFD Display
+	vfdInit();
 	//Start Up Beep
 	Beep(100);
-	//Enable Interrupts
-	sei();
 }
 
 int main(void)
 {
 	//Initialize Hardware
 	InitializeHardware();
-	//Run the UI with no menu - Shows the Title screen
-	UI_Service();
-	_delay_ms(3000);
-	//Activate The First Menu		
-	uiObj_Activate(1);
-	//Clear the VFD
-	vfdClr();
+	//The UI starts with no menu - Shows the Title screen until it times out or there is input
 	
 	//Main Program Loop
 	while(1){
@@ -183,6 +345,8 @@ int main(void)
 		UI_Service();
 		//Run the Welding Control System
 		WELD_Service();
+		//Keep the warm restart state up to date
+		SaveWarmState();
 	}
 
 }
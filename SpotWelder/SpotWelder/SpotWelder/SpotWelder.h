@@ -47,6 +47,7 @@
 #include <avr/eeprom.h>
 #include <util/delay.h>
 #include <util/atomic.h>
+#include <util/crc16.h>
 
 //UI data Declarations and helper functions
 #include "UIControl.h"
@@ -54,20 +55,47 @@
 
 //Main Weld control helpers
 #include "WeldCtrl.h"
+#include "WeldLog.h"
+#include "ProbeID.h"
+
+//Diagnostics
+#include "Trace.h"
 
 //Internal Peripheral Drivers:
 #include "Drivers/SPI_AVR8_Fixed.h"		//SPI Peripheral
 #include "Drivers/GPIO.h"				//GPIO Definitions
 #include "Drivers/TimerControl.h"		//Timer Functions
+#include "Drivers/EEQueue.h"			//Asynchronous EEPROM Writer
+#include "Drivers/ADCDrv.h"				//ADC Acquisition
+#include "Drivers/Serial.h"				//Serial Transmit
+#include "Drivers/LoadCell.h"			//Load Cell (Electrode force)
 
 //External Hardware Drivers:
 #include "Drivers/VFDDrv.h"				//VFD/LCD Driver
 #include "Drivers/MCP48XX.h"			//DAC driver
 
 //Custom Types
+//Warm restart state (Kept in .noinit SRAM through a reset)
+typedef struct warmstate_s_t
+{
+	weldctrl_s_t Settings;			//Weld Settings
+	uint16_t AREF_Cal;				//Calibrated AREF
+	uint8_t  TrigLevel;				//DAC Setting (Contact Trigger Level)
+	UIObjHandle Menu;				//Active Menu
+	uint16_t CRC;					//CRC16 of all of the above
+} warmstate_s_t;
+
 //Function Prototypes
 void InitializeHardware(void);
 //Load settings from EEPROM
 void LoadSettings(void);
+//Fix weld settings this welder can't use. Returns 1 if anything was changed
+uint8_t ValidateSettings(void);
+//Queue all settings to be written to EEPROM
+void SaveSettings(void);
+//Update the warm restart state
+void SaveWarmState(void);
+//Restore the state from before a reset. Returns 1 if restored, 0 if not 
+uint8_t RestoreWarmState(void);
 
 #endif
@@ -0,0 +1,171 @@
+//*****************************************************************************
+//
+// File Name	: 'Trace.c'
+// Title		: MiniWeld Pro Miniature Spot Welder - Post-mortem state trace
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+//Notes:
+//The trace ring lives in .noinit SRAM, so it is not cleared by a watchdog,
+//brown-out or external reset.  On start up, TRACE_Init() checks the reset 
+//cause, and if the ring survived a reset that was not a power on, it is 
+//copied to EEPROM (in the background) where it can be viewed later from the
+//Diagnostics menu.  The ring then carries on from where it left off.
+//
+//MCUSR has to be read (and cleared) before anything else runs, so it is 
+//grabbed in .init3, which also turns off the watchdog in case it caused the
+//reset (it stays enabled after a watchdog reset).
+
+#include <stddef.h>
+#include <avr/wdt.h>
+
+#include "SpotWelder.h"
+
+//EEPROM data and Variables
+trace_ring_s_t EEMEM ee_TRACE_SNAPSHOT;						//Trace ring saved after the last reset
+
+//Trace Local Variables *******************************************************
+//Trace ring and reset flags - Not cleared on reset!
+static trace_ring_s_t TraceRing __attribute__ ((section (".noinit")));
+static uint8_t ResetCause __attribute__ ((section (".noinit")));
+
+//Copy of the ring for the EEPROM writer 
+static trace_ring_s_t Snapshot;
+
+//Function implementations ****************************************************
+
+//Grab the reset cause before the C runtime starts (Runs from .init3)
+void TRACE_GetMCUSR(void) __attribute__ ((naked, used, section (".init3")));
+void TRACE_GetMCUSR(void){
+	
+	ResetCause = MCUSR;
+	MCUSR = 0;
+	wdt_disable();
+}
+
+//Trace Functions *********
+//Check the reset cause and save the trace ring to EEPROM if it survived
+void TRACE_Init(void){
+	
+	//Is the ring still good?
+	if( (TraceRing.Magic == _TRACE_MAGIC) && (TraceRing.Index < _TRACE_LEN) ){
+		//Save it if this was not a power on reset
+		if( !(ResetCause & _BV(PORF)) && 
+		     (ResetCause & (_BV(WDRF) | _BV(BORF) | _BV(EXTRF) | _BV(JTRF))) ){
+			memcpy((void*)&Snapshot, (const void*)&TraceRing, sizeof(trace_ring_s_t));
+			Snapshot.Cause = ResetCause;
+			EEQ_UpdateBlock(&Snapshot, &ee_TRACE_SNAPSHOT, sizeof(trace_ring_s_t));
+		}
+	}else{
+		//Start a new ring
+		memset((void*)&TraceRing, 0, sizeof(trace_ring_s_t));
+		TraceRing.Magic = _TRACE_MAGIC;
+	}
+	
+	//Mark the reset in the ring
+	TRACE_Event(TrcEvt_Reset, ResetCause);
+}
+
+//Add an event to the trace ring (Safe from ISRs)
+void TRACE_Event(traceevent_e_t Event, uint8_t Data){
+	
+	trace_entry_s_t* Entry;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		Entry = &TraceRing.Entry[TraceRing.Index];
+		Entry->TS = (uint16_t)GetSysTicks();
+		Entry->Event = (uint8_t)Event;
+		Entry->Data = Data;
+		if(++TraceRing.Index >= _TRACE_LEN) TraceRing.Index = 0;
+	}
+}
+
+//Set an ISR overrun flag (Safe from ISRs)
+void TRACE_Overrun(uint8_t Flag){
+	
+	//Only trace the first time each flag is seen
+	if(!(TraceRing.Overrun & Flag)){
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+			TraceRing.Overrun |= Flag;
+		}
+		TRACE_Event(TrcEvt_Overrun, Flag);
+	}
+}
+
+//Save the time of the last zero cross (Called from the zero cross ISR)
+void TRACE_ZeroX(uint32_t TS){
+	
+	TraceRing.LastZeroXTS = TS;
+}
+
+//Get the reset cause (MCUSR flags) of the last reset
+uint8_t TRACE_GetResetCause(void){
+	
+	return ResetCause;
+}
+
+//Get the ISR overrun flags seen since the ring was started
+uint8_t TRACE_GetOverrun(void){
+	
+	return TraceRing.Overrun;
+}
+
+//Snapshot (EEPROM) Functions *********
+//Read the snapshot header. Returns 1 if a snapshot has been saved, 0 if not
+uint8_t TRACE_GetSnapshotInfo(trace_ring_s_t* Info){
+	
+	//Only read the header
+	EEQ_ReadBlock(Info, &ee_TRACE_SNAPSHOT, offsetof(trace_ring_s_t, Entry));
+	
+	return ( (Info->Magic == _TRACE_MAGIC) && (Info->Index < _TRACE_LEN) );
+}
+
+//Read a snapshot entry; Age 0 = Newest.  Returns 1 if valid, 0 if not
+uint8_t TRACE_GetSnapshotEntry(uint8_t Age, trace_entry_s_t* Entry){
+	
+	uint16_t Magic;
+	uint8_t Index;
+	
+	if(Age >= _TRACE_LEN) return 0;
+	
+	//Any snapshot saved?
+	EEQ_ReadBlock(&Magic, &ee_TRACE_SNAPSHOT.Magic, sizeof(Magic));
+	EEQ_ReadBlock(&Index, &ee_TRACE_SNAPSHOT.Index, sizeof(Index));
+	if( (Magic != _TRACE_MAGIC) || (Index >= _TRACE_LEN) ) return 0;
+	
+	//Work back from the newest
+	Index = (Index + _TRACE_LEN - 1 - Age) % _TRACE_LEN;
+	EEQ_ReadBlock(Entry, &ee_TRACE_SNAPSHOT.Entry[Index], sizeof(trace_entry_s_t));
+	
+	//Unused entries are cleared
+	return (Entry->Event != 0);
+}
@@ -0,0 +1,104 @@
+//*****************************************************************************
+//
+// File Name	: 'Trace.h'
+// Title		: MiniWeld Pro Miniature Spot Welder - Post-mortem state trace
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <avr/io.h>
+
+//Trace settings
+#define _TRACE_LEN					32			//Entries in the trace ring
+#define _TRACE_MAGIC				0x5754		//Marks a trace ring that survived a reset
+
+//ISR Overrun flags
+#define _TRACE_OVR_WELDTMR			0x01		//Weld timer ISR ran longer than a weld tick
+#define _TRACE_OVR_ZEROX			0x02		//Zero cross wait timed out inside the weld timer ISR
+
+//Trace Event Enum
+typedef enum traceevent_e_t
+{
+	TrcEvt_Reset		=	1,		//Data = MCUSR reset flags
+	TrcEvt_WeldStage	=	2,		//Data = weldcycle_enum_t
+	TrcEvt_Trigger		=	3,		//Data = Trigger state (See IsWeldTriggered())
+	TrcEvt_ZeroXLost	=	4,		//Data = 0
+	TrcEvt_ZeroXFound	=	5,		//Data = 0
+	TrcEvt_Overrun		=	6,		//Data = ISR Overrun flag
+	TrcEvt_Fault		=	7,		//Data = weldfault_e_t
+	TrcEvt_Ready		=	8,		//Data = Boot to ready time (mS, 255 = 255 or more)
+	TrcEvt_Probe		=	9,		//Data = Probe ID (New probe's settings loaded)
+	TrcEvt_LogDrop		=	10		//Data = Weld log records dropped so far (255 = 255 or more)
+}traceevent_e_t;
+
+//Trace entry
+typedef struct trace_entry_s_t
+{
+	uint16_t TS;					//System ticks (Low 16 bits)
+	uint8_t  Event;					//traceevent_e_t
+	uint8_t  Data;					//Event data
+} trace_entry_s_t;
+
+//Trace ring (Kept in .noinit SRAM, and copied to EEPROM after a reset)
+typedef struct trace_ring_s_t
+{
+	uint16_t Magic;					//_TRACE_MAGIC if valid
+	uint8_t  Index;					//Next entry to write
+	uint8_t  Overrun;				//ISR Overrun flags seen
+	uint8_t  Cause;					//Reset cause (MCUSR) - Snapshot only 
+	uint32_t LastZeroXTS;			//System ticks at last zero cross
+	trace_entry_s_t Entry[_TRACE_LEN];
+} trace_ring_s_t;
+
+//Trace Functions *********
+//Check the reset cause and save the trace ring to EEPROM if it survived
+void TRACE_Init(void);
+//Add an event to the trace ring (Safe from ISRs)
+void TRACE_Event(traceevent_e_t Event, uint8_t Data);
+//Set an ISR overrun flag (Safe from ISRs)
+void TRACE_Overrun(uint8_t Flag);
+//Save the time of the last zero cross (Called from the zero cross ISR)
+void TRACE_ZeroX(uint32_t TS);
+//Get the reset cause (MCUSR flags) of the last reset
+uint8_t TRACE_GetResetCause(void);
+//Get the ISR overrun flags seen since the ring was started
+uint8_t TRACE_GetOverrun(void);
+
+//Snapshot (EEPROM) Functions *********
+//Read the snapshot header. Returns 1 if a snapshot has been saved, 0 if not
+uint8_t TRACE_GetSnapshotInfo(trace_ring_s_t* Info);
+//Read a snapshot entry; Age 0 = Newest.  Returns 1 if valid, 0 if not
+uint8_t TRACE_GetSnapshotEntry(uint8_t Age, trace_entry_s_t* Entry);
+
+#endif /* TRACE_H_ */
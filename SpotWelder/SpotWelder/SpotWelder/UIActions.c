@@ -42,10 +42,16 @@ extern weldctrl_s_t WeldSettings;
 extern uint8_t ContactTrigLevel;
 
 extern uint16_t	EEMEM ee_WELD_VOLTAGE_MV;			//Weld Voltage in mV
+extern uint16_t	EEMEM ee_WELD_ENERGY_J;				//Weld Energy in J
+extern uint16_t	EEMEM ee_WELD_CURRENT_A;			//Weld Current in A
+extern uint16_t	EEMEM ee_WELD_FORCE_N;				//Electrode Force in N
 extern uint16_t	EEMEM ee_WELD_P0_LENGTH	;			//Weld Pulse 0 Length (mS)
 extern uint16_t	EEMEM ee_WELD_P1_LENGTH ;			//Weld Pulse 1 Length (mS)
 extern uint16_t	EEMEM ee_WELD_IP_DELAY	;			//Inter-pulse Delay length (mS)
 extern uint16_t	EEMEM ee_WELD_TRIG_DELAY;			//Trigger Delay (mS)
+extern uint16_t	EEMEM ee_WELD_SQUEEZE;				//Squeeze Time (mS)
+extern uint16_t	EEMEM ee_WELD_HOLD;					//Hold Time (mS)
+extern uint16_t	EEMEM ee_WELD_OFF;					//Off Time (mS, 0 = No repeat)
 extern uint16_t	EEMEM ee_WELD_TRIGGER	;			//Weld Trigger Type (See SpotWelder.h for Trigger Type Enum)
 extern uint16_t	EEMEM ee_WELD_TYPE		;			//Weld Pulse Type
 extern uint8_t	EEMEM ee_DAC_Setting	;			//Contact Trigger Threshold
@@ -61,6 +67,15 @@ static swstatus_s_t MySwitchStatus;
 static char DispValue[16];
 static char Number[9];
 
+//Trigger names (Indexed by weldtrigger_e_t)
+static const uiTrigNames_s_t uiTrigNames[uiNumTrigs] PROGMEM = {
+	{"Foot-switch Trig", "FS"},			//wTrigFootSwitch
+	{"Contact Det Trig", "CT"},			//wTrigContact
+	{"Elec. Force Trig", "FC"},			//wTrigForce
+	{"Contact+Foot Sw ", "CF"},			//wTrigContactFS
+	{"Foot-sw Stitch  ", "ST"}			//wTrigStitch
+};
+
 //UI Helper functions *********************************************************
 //UI Menu initializer - Each Menu needs an entry
 int uiHelper_LoadMenus(void){
@@ -153,11 +168,12 @@ int uiHelper_LoadMenus(void){
 	tempMenuObj.Next = 7;
 	tempMenuObj.Current.MenuText    = PSTR("Set Trig Level -");
 	tempMenuObj.Current.MenuTextLen = 16;
-	tempMenuObj.Current.ActionText  = PSTR("GO...     View");
+	tempMenuObj.Current.ActionText  = PSTR("GO.. Auto View");
 	tempMenuObj.Current.ActionTextLen = 14;
 	tempMenuObj.Current.TargetParam = (void*)&ContactTrigLevel;
 	tempMenuObj.Current.ActionFunc1 = &uiAct_SetTrigThrsh;
 	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowTrigThrsh;
+	tempMenuObj.Current.ActionFunc3 = &uiAct_CalTrigThrsh;
 	
 	tempHandle = uiObj_Register(&tempMenuObj);
 	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
@@ -173,13 +189,151 @@ int uiHelper_LoadMenus(void){
 	tempMenuObj.Current.TargetParam = (void*)&WeldSettings.Trig_Delay;
 	tempMenuObj.Current.ActionFunc1 = &uiAct_SetWeldType;
 	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowWeldType;
+	tempMenuObj.Current.ActionFunc3 = 0;
 	
 	tempHandle = uiObj_Register(&tempMenuObj);
 	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
 	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
 		
-	//Reset Defaults 
+	//Capacitor Voltage Menu
 	tempMenuObj.Prev = tempHandle;  //Previous is Weld Type Menu
+	tempMenuObj.Next = 9;
+	tempMenuObj.Current.MenuText    = PSTR("Set CD Voltage -");
+	tempMenuObj.Current.MenuTextLen = 16;
+	tempMenuObj.Current.ActionText  = PSTR("GO...     View");
+	tempMenuObj.Current.ActionTextLen = 14;
+	tempMenuObj.Current.TargetParam = (void*)&WeldSettings.Voltage;
+	tempMenuObj.Current.ActionFunc1 = &uiAct_SetVoltage;
+	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowVoltage;
+	
+	tempHandle = uiObj_Register(&tempMenuObj);
+	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
+	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
+		
+	//Energy Target Menu
+	tempMenuObj.Prev = tempHandle;  //Previous is CD Voltage Menu
+	tempMenuObj.Next = 10;
+	tempMenuObj.Current.MenuText    = PSTR("Set Energy    - ");
+	tempMenuObj.Current.MenuTextLen = 16;
+	tempMenuObj.Current.ActionText  = PSTR("GO...     View");
+	tempMenuObj.Current.ActionTextLen = 14;
+	tempMenuObj.Current.TargetParam = (void*)&WeldSettings.Energy;
+	tempMenuObj.Current.ActionFunc1 = &uiAct_SetEnergy;
+	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowEnergy;
+	
+	tempHandle = uiObj_Register(&tempMenuObj);
+	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
+	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
+		
+	//Current Target Menu
+	tempMenuObj.Prev = tempHandle;  //Previous is Energy Menu
+	tempMenuObj.Next = 11;
+	tempMenuObj.Current.MenuText    = PSTR("Set Current   - ");
+	tempMenuObj.Current.MenuTextLen = 16;
+	tempMenuObj.Current.ActionText  = PSTR("GO...     View");
+	tempMenuObj.Current.ActionTextLen = 14;
+	tempMenuObj.Current.TargetParam = (void*)&WeldSettings.Current;
+	tempMenuObj.Current.ActionFunc1 = &uiAct_SetCurrent;
+	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowCurrent;
+	
+	tempHandle = uiObj_Register(&tempMenuObj);
+	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
+	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
+		
+	//Force Setpoint Menu
+	tempMenuObj.Prev = tempHandle;  //Previous is Current Menu
+	tempMenuObj.Next = 12;
+	tempMenuObj.Current.MenuText    = PSTR("Set Trig Force -");
+	tempMenuObj.Current.MenuTextLen = 16;
+	tempMenuObj.Current.ActionText  = PSTR("GO...     View");
+	tempMenuObj.Current.ActionTextLen = 14;
+	tempMenuObj.Current.TargetParam = (void*)&WeldSettings.Force;
+	tempMenuObj.Current.ActionFunc1 = &uiAct_SetForce;
+	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowForce;
+	
+	tempHandle = uiObj_Register(&tempMenuObj);
+	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
+	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
+		
+	//Squeeze Time Menu
+	tempMenuObj.Prev = tempHandle;  //Previous is Force Menu
+	tempMenuObj.Next = 13;
+	tempMenuObj.Current.MenuText    = PSTR("Set Squeeze   - ");
+	tempMenuObj.Current.MenuTextLen = 16;
+	tempMenuObj.Current.ActionText  = PSTR("GO...     View");
+	tempMenuObj.Current.ActionTextLen = 14;
+	tempMenuObj.Current.TargetParam = (void*)&WeldSettings.Squeeze_Time;
+	tempMenuObj.Current.ActionFunc1 = &uiAct_SetSqueezeTime;
+	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowSqueezeTime;
+	
+	tempHandle = uiObj_Register(&tempMenuObj);
+	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
+	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
+		
+	//Hold Time Menu
+	tempMenuObj.Prev = tempHandle;  //Previous is Squeeze Menu
+	tempMenuObj.Next = 14;
+	tempMenuObj.Current.MenuText    = PSTR("Set Hold Time - ");
+	tempMenuObj.Current.MenuTextLen = 16;
+	tempMenuObj.Current.ActionText  = PSTR("GO...     View");
+	tempMenuObj.Current.ActionTextLen = 14;
+	tempMenuObj.Current.TargetParam = (void*)&WeldSettings.Hold_Time;
+	tempMenuObj.Current.ActionFunc1 = &uiAct_SetHoldTime;
+	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowHoldTime;
+	
+	tempHandle = uiObj_Register(&tempMenuObj);
+	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
+	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
+		
+	//Off Time (Repeat) Menu
+	tempMenuObj.Prev = tempHandle;  //Previous is Hold Menu
+	tempMenuObj.Next = 15;
+	tempMenuObj.Current.MenuText    = PSTR("Set Off Time  - ");
+	tempMenuObj.Current.MenuTextLen = 16;
+	tempMenuObj.Current.ActionText  = PSTR("GO...     View");
+	tempMenuObj.Current.ActionTextLen = 14;
+	tempMenuObj.Current.TargetParam = (void*)&WeldSettings.Off_Time;
+	tempMenuObj.Current.ActionFunc1 = &uiAct_SetOffTime;
+	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowOffTime;
+	
+	tempHandle = uiObj_Register(&tempMenuObj);
+	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
+	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
+		
+	//Weld Counters and Log
+	tempMenuObj.Prev = tempHandle;  //Previous is Off Time Menu
+	tempMenuObj.Next = 16;
+	tempMenuObj.Current.MenuText    = PSTR("Weld Counters - ");
+	tempMenuObj.Current.MenuTextLen = 16;
+	tempMenuObj.Current.ActionText  = PSTR("Log...    View");
+	tempMenuObj.Current.ActionTextLen = 14;
+	tempMenuObj.Current.TargetParam = 0;
+	tempMenuObj.Current.ActionFunc1 = &uiAct_ShowWeldLog;
+	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowCounters;
+	tempMenuObj.Current.ActionFunc3 = &uiAct_ResetShift;
+	
+	tempHandle = uiObj_Register(&tempMenuObj);
+	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
+	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
+		
+	//Diagnostics
+	tempMenuObj.Prev = tempHandle;  //Previous is Weld Counters Menu
+	tempMenuObj.Next = 17;
+	tempMenuObj.Current.MenuText    = PSTR("Diagnostics   - ");
+	tempMenuObj.Current.MenuTextLen = 16;
+	tempMenuObj.Current.ActionText  = PSTR("Trc. Dump View");
+	tempMenuObj.Current.ActionTextLen = 14;
+	tempMenuObj.Current.TargetParam = 0;
+	tempMenuObj.Current.ActionFunc1 = &uiAct_ShowTrace;
+	tempMenuObj.Current.ActionFunc2 = &uiAct_ShowDiagnostics;
+	tempMenuObj.Current.ActionFunc3 = &uiAct_DumpChatter;
+	
+	tempHandle = uiObj_Register(&tempMenuObj);
+	MenuIDs[MenuIndex] = (uint8_t) ((0x00000FFF & GetSysTicks()) | (MenuIndex << 4));
+	tempObjPtr->MenuUID = MenuIDs[MenuIndex++];
+		
+	//Reset Defaults 
+	tempMenuObj.Prev = tempHandle;  //Previous is Diagnostics Menu
 	tempMenuObj.Next = _uiObjVoidHandle;
 	tempMenuObj.Current.MenuText    = PSTR("Reset Defaults -");
 	tempMenuObj.Current.MenuTextLen = 16;
@@ -403,6 +557,57 @@ void uiHelper_DisplayNumeric(void* Param, const char* Units, uint8_t lenUnits){
 	vfdClr();
 	
 }
+//Wait for a button press: 1 = SW A, 2 = SW B, 3 = Both, 0 = Timed out (No input for _UI_ACT_TIMEOUT_MS)
+uint8_t uiHelper_WaitButton(void){
+	
+	uint8_t Pressed = 0;
+	uint32_t Timeout;
+	
+	UI_ResetInputState(&MySwitchStatus);
+	Timeout = GetSysTicks() + (_UI_ACT_TIMEOUT_MS / _MS_PER_SYSTICK);
+	
+	while(!Pressed){
+		//Keep the weld system running (Welding is disabled while in a menu)
+		WELD_Service();
+		UI_ProcessInput(&MySwitchStatus);
+		if(MySwitchStatus.swC_Duration)			Pressed = 3;
+		else if(MySwitchStatus.swA_Duration)	Pressed = 1;
+		else if(MySwitchStatus.swB_Duration)	Pressed = 2;
+		//Idle too long - Give up, as the UI would
+		else if(GetSysTicks() > Timeout)		break;
+	}
+	
+	UI_ResetInputState(&MySwitchStatus);
+	if(Pressed) UI_ResetActivity();
+	
+	return Pressed;
+}
+
+//Get the names of a trigger type (Program memory - unknown types are the foot switch)
+const uiTrigNames_s_t* uiHelper_TrigNames(uint8_t Trigger){
+	
+	if(Trigger >= uiNumTrigs) Trigger = wTrigFootSwitch;
+	return &uiTrigNames[Trigger];
+}
+
+//Write a number into a string, right justified in Width characters
+void uiHelper_FormatNumber(char* Dest, uint32_t Val, uint8_t Width){
+	
+	char Digits[11];
+	uint8_t numLen;
+	
+	//generate string of value
+	ultoa(Val, Digits, 10);
+	numLen = strlen(Digits);
+	//Too big? Show the low digits
+	if(numLen > Width){
+		memcpy((void*)Dest, (const void*)&Digits[numLen - Width], Width);
+		return;
+	}
+	//Pad on the left 
+	memset((void*)Dest, 0x20, Width - numLen);
+	memcpy((void*)&Dest[Width - numLen], (const void*)Digits, numLen);
+}
 
 //UI Action function Definitions **********************************************
 //Each menu requires at least one action
@@ -419,7 +624,7 @@ int uiAct_SetP0Time(void){
 		_MINWeldPulseLength_mS) )
 		{
 			WeldSettings.P0_Length = TempVal;							 
-			eeprom_update_word(&ee_WELD_P0_LENGTH, TempVal);
+			EEQ_UpdateWord(&ee_WELD_P0_LENGTH, TempVal);
 		}
 
 	return 0;
@@ -443,7 +648,7 @@ int uiAct_SetP1Time(void){
 	_MINWeldPulseLength_mS) )
 	{
 		WeldSettings.P1_Length = TempVal;
-		eeprom_update_word(&ee_WELD_P1_LENGTH, TempVal);
+		EEQ_UpdateWord(&ee_WELD_P1_LENGTH, TempVal);
 	}
 
 	return 0;
@@ -467,7 +672,7 @@ int uiAct_SetIPTime(void){
 	_MINWeldPulseDelay_mS) )
 	{
 		WeldSettings.IP_Delay = TempVal;
-		eeprom_update_word(&ee_WELD_IP_DELAY, TempVal);
+		EEQ_UpdateWord(&ee_WELD_IP_DELAY, TempVal);
 	}
 
 	return 0;
@@ -482,16 +687,16 @@ int uiAct_ShowIPTime(void){
 //Action to Set Trig Delay Time
 int uiAct_SetTrigDlyTime(void){
 	
-	TempVal = WeldSettings.IP_Delay;
+	TempVal = WeldSettings.Trig_Delay;
 	
 	if( uiHelper_SetNumericParam(&TempVal,
 	_MAXWeldPulseDelay_mS,
-	_MINWeldPulseDelay_mS,
+	_MINTrigDelay_mS,
 	_WeldDef_TrigDel,
 	_MINWeldPulseDelay_mS) )
 	{
 		WeldSettings.Trig_Delay = TempVal;
-		eeprom_update_word(&ee_WELD_TRIG_DELAY, TempVal);
+		EEQ_UpdateWord(&ee_WELD_TRIG_DELAY, TempVal);
 	}
 
 	return 0;
@@ -499,7 +704,10 @@ int uiAct_SetTrigDlyTime(void){
 }
 int uiAct_ShowTrigDlyTime(void){
 	
-	uiHelper_DisplayNumeric(&WeldSettings.Trig_Delay, PSTR("ms"), 2);
+	if(WeldSettings.Trig_Delay)
+		uiHelper_DisplayNumeric(&WeldSettings.Trig_Delay, PSTR("ms"), 2);
+	else
+		uiHelper_DisplayNumeric(&WeldSettings.Trig_Delay, PSTR("ms Min Lat."), 11);
 	return 0;
 	
 }
@@ -513,14 +721,9 @@ int uiAct_SetTrigType(void){
 	//Reset the input state 
 	UI_ResetInputState(&MySwitchStatus);
 		
-	//Set Current Value 
-	if(WeldSettings.Trigger == wTrigContact){
-		CurTrig = wTrigContact;
-		NewTrig = wTrigFootSwitch;
-	}else{
-		CurTrig = wTrigFootSwitch;
-		NewTrig = wTrigContact;
-	}
+	//Set Current Value (New is out of range so the first pass displays it)
+	CurTrig = (WeldSettings.Trigger < uiNumTrigs) ? WeldSettings.Trigger : wTrigFootSwitch;
+	NewTrig = (weldtrigger_e_t)uiNumTrigs;
 	
 	//Edit loop
 	while(1){
@@ -531,10 +734,7 @@ int uiAct_SetTrigType(void){
 			//Save new Value 
 			NewTrig = CurTrig;
 			//Display Value...
-			if(NewTrig == wTrigContact)
-				vfdPrintStrXY(PSTR("Contact Det Trig"), 16, 0, 0, _vfdTHISPage);
-			else
-				vfdPrintStrXY(PSTR("Foot-switch Trig"), 16, 0, 0, _vfdTHISPage);
+			vfdPrintStrXY(uiHelper_TrigNames(NewTrig)->Name, 16, 0, 0, _vfdTHISPage);
 			//Display action Caption
 			vfdPrintStrXY(PSTR("Save            "), 16, 0, 1, _vfdTHISPage);
 		}
@@ -544,10 +744,8 @@ int uiAct_SetTrigType(void){
 		if(MySwitchStatus.encChange == SW_IsChange){
 			//Encoder state changed
 			if(MySwitchStatus.encCount >= 1){
-				if(CurTrig == wTrigContact)
-					CurTrig = wTrigFootSwitch;
-				else
-					CurTrig = wTrigContact;
+				//Next in the table, back to the start after the last
+				CurTrig = (weldtrigger_e_t)((CurTrig + 1) % uiNumTrigs);
 			}
 			//Reset status 
 			UI_ResetInputState(&MySwitchStatus);
@@ -560,10 +758,10 @@ int uiAct_SetTrigType(void){
 			   (MySwitchStatus.swA_Duration == 2) ){
 				//Switch was pressed
 				//Check if Trigger type is allowed for Weld mode
-				if(NewTrig == wTrigContact){
+				if(NewTrig != wTrigFootSwitch){
 					//Check Weld Type Setting
 					if(WeldSettings.Type == wTypeContinuous){
-						//Contact Trigger not allowed for Continuous mode
+						//Contact and Force Triggers not allowed for Continuous mode
 						vfdClr();
 						vfdPrintStrXY(PSTR("Invalid  for"), 12, 2,0, _vfdTHISPage);
 						vfdPrintStrXY(PSTR("Continuous Mode!"), 16, 0, 1, _vfdTHISPage);
@@ -578,7 +776,7 @@ int uiAct_SetTrigType(void){
 				//check if we need to save
 				if(SaveSetting){
 					WeldSettings.Trigger = NewTrig;
-					eeprom_update_word(&ee_WELD_TRIGGER, (uint16_t)NewTrig);
+					EEQ_UpdateWord(&ee_WELD_TRIGGER, (uint16_t)NewTrig);
 					//indicate to user
 					vfdClr();
 					vfdPrintStrXY(PSTR("Setting Saved..."), 16, 0, 0, _vfdTHISPage);
@@ -600,10 +798,7 @@ int uiAct_ShowTrigType(void){
 	
 	vfdClr();
 	//Display Value...
-	if(WeldSettings.Trigger == wTrigContact)
-		vfdPrintStrXY(PSTR("Contact Det Trig"), 16, 0, 0, _vfdTHISPage);
-	else
-		vfdPrintStrXY(PSTR("Foot-switch Trig"), 16, 0, 0, _vfdTHISPage);
+	vfdPrintStrXY(uiHelper_TrigNames(WeldSettings.Trigger)->Name, 16, 0, 0, _vfdTHISPage);
 	
 	_delay_ms(uiViewDelayMS);
 	
@@ -632,6 +827,18 @@ int uiAct_SetWeldType(void){
 		CurWeld = wTypeSinglePulse;
 		NewWeld = wTypeContinuous;
 	}
+	if( WeldSettings.Type == wTypeCapDischarge){
+		CurWeld = wTypeCapDischarge;
+		NewWeld = wTypeContinuous;
+	}
+	if( WeldSettings.Type == wTypeEnergy){
+		CurWeld = wTypeEnergy;
+		NewWeld = wTypeContinuous;
+	}
+	if( WeldSettings.Type == wTypeConstCurrent){
+		CurWeld = wTypeConstCurrent;
+		NewWeld = wTypeContinuous;
+	}
 	
 	//Edit loop
 	while(1){
@@ -648,6 +855,12 @@ int uiAct_SetWeldType(void){
 				vfdPrintStrXY(PSTR(" Dbl Pulse Weld "), 16, 0, 0, _vfdTHISPage);
 			if(NewWeld == wTypeSinglePulse)
 			    vfdPrintStrXY(PSTR(" Sgl Pulse Weld "), 16, 0, 0, _vfdTHISPage);
+			if(NewWeld == wTypeCapDischarge)
+			    vfdPrintStrXY(PSTR(" Cap Discharge  "), 16, 0, 0, _vfdTHISPage);
+			if(NewWeld == wTypeEnergy)
+			    vfdPrintStrXY(PSTR("  Energy  Weld  "), 16, 0, 0, _vfdTHISPage);
+			if(NewWeld == wTypeConstCurrent)
+			    vfdPrintStrXY(PSTR(" Const Current  "), 16, 0, 0, _vfdTHISPage);
 			//Display action Caption
 			vfdPrintStrXY(PSTR("Save            "), 16, 0, 1, _vfdTHISPage);
 		}
@@ -664,6 +877,19 @@ int uiAct_SetWeldType(void){
 					CurWeld = wTypeDoublePulse;
 				}
 				else if (CurWeld == wTypeDoublePulse){
+#if defined( _FORCE_SOLENOID_FITTED )
+					CurWeld = wTypeEnergy;			//No charger fitted
+#else
+					CurWeld = wTypeCapDischarge;
+#endif
+				}
+				else if (CurWeld == wTypeCapDischarge){
+					CurWeld = wTypeEnergy;
+				}
+				else if (CurWeld == wTypeEnergy){
+					CurWeld = wTypeConstCurrent;
+				}
+				else if (CurWeld == wTypeConstCurrent){
 					CurWeld = wTypeContinuous;
 				}
 			}
@@ -687,10 +913,10 @@ int uiAct_SetWeldType(void){
 					vfdPrintStrXY(PSTR("Foot  Sw"),8 ,4 ,1 , _vfdTHISPage);
 					_delay_ms(uiViewDelayMS);
 					WeldSettings.Trigger = wTrigFootSwitch;
-					eeprom_update_word(&ee_WELD_TYPE, (uint16_t)NewWeld);
+					EEQ_UpdateWord(&ee_WELD_TYPE, (uint16_t)NewWeld);
 				}
 				//Save New Weld Type
-				eeprom_update_word(&ee_WELD_TRIGGER, (uint16_t)wTrigFootSwitch);
+				EEQ_UpdateWord(&ee_WELD_TRIGGER, (uint16_t)wTrigFootSwitch);
 				//indicate to user
 				vfdClr();
 				vfdPrintStrXY(PSTR("Setting Saved..."), 16, 0, 0, _vfdTHISPage);
@@ -720,6 +946,12 @@ int uiAct_ShowWeldType(void){
 		vfdPrintStrXY(PSTR(" Dbl Pulse Weld "), 16, 0, 0, _vfdTHISPage);
 	if(WeldSettings.Type == wTypeSinglePulse)
 		vfdPrintStrXY(PSTR(" Sgl Pulse Weld "), 16, 0, 0, _vfdTHISPage);
+	if(WeldSettings.Type == wTypeCapDischarge)
+		vfdPrintStrXY(PSTR(" Cap Discharge  "), 16, 0, 0, _vfdTHISPage);
+	if(WeldSettings.Type == wTypeEnergy)
+		vfdPrintStrXY(PSTR("  Energy  Weld  "), 16, 0, 0, _vfdTHISPage);
+	if(WeldSettings.Type == wTypeConstCurrent)
+		vfdPrintStrXY(PSTR(" Const Current  "), 16, 0, 0, _vfdTHISPage);
 	
 	_delay_ms(uiViewDelayMS);
 	
@@ -727,6 +959,182 @@ int uiAct_ShowWeldType(void){
 	
 	return 0;
 }
+//Action to Set the Capacitor Discharge Voltage
+int uiAct_SetVoltage(void){
+	
+	TempVal = WeldSettings.Voltage;
+	
+	if( uiHelper_SetNumericParam(&TempVal,
+	_MAXWeldVoltage_mV,
+	_MINWeldVoltage_mV,
+	_WeldDef_Voltage,
+	_StepWeldVoltage_mV) )
+	{
+		WeldSettings.Voltage = TempVal;
+		EEQ_UpdateWord(&ee_WELD_VOLTAGE_MV, TempVal);
+	}
+
+	return 0;
+	
+}
+int uiAct_ShowVoltage(void){
+	
+	uiHelper_DisplayNumeric(&WeldSettings.Voltage, PSTR("mV"), 2);
+	return 0;
+	
+}
+//Action to Set the Energy Target
+int uiAct_SetEnergy(void){
+	
+	TempVal = WeldSettings.Energy;
+	
+	if( uiHelper_SetNumericParam(&TempVal,
+	_MAXWeldEnergy_J,
+	_MINWeldEnergy_J,
+	_WeldDef_Energy,
+	_StepWeldEnergy_J) )
+	{
+		WeldSettings.Energy = TempVal;
+		EEQ_UpdateWord(&ee_WELD_ENERGY_J, TempVal);
+	}
+
+	return 0;
+	
+}
+int uiAct_ShowEnergy(void){
+	
+	uiHelper_DisplayNumeric(&WeldSettings.Energy, PSTR("J "), 2);
+	return 0;
+	
+}
+//Action to Set the Current Target
+int uiAct_SetCurrent(void){
+	
+	TempVal = WeldSettings.Current;
+	
+	if( uiHelper_SetNumericParam(&TempVal,
+	_MAXWeldCurrent_A,
+	_MINWeldCurrent_A,
+	_WeldDef_Current,
+	_StepWeldCurrent_A) )
+	{
+		WeldSettings.Current = TempVal;
+		EEQ_UpdateWord(&ee_WELD_CURRENT_A, TempVal);
+	}
+
+	return 0;
+	
+}
+int uiAct_ShowCurrent(void){
+	
+	uiHelper_DisplayNumeric(&WeldSettings.Current, PSTR("A "), 2);
+	return 0;
+	
+}
+//Action to Set the Force Trigger Setpoint
+int uiAct_SetForce(void){
+	
+	TempVal = WeldSettings.Force;
+	
+	if( uiHelper_SetNumericParam(&TempVal,
+	_MAXWeldForce_N,
+	_MINWeldForce_N,
+	_WeldDef_Force,
+	_StepWeldForce_N) )
+	{
+		WeldSettings.Force = TempVal;
+		EEQ_UpdateWord(&ee_WELD_FORCE_N, TempVal);
+	}
+
+	return 0;
+	
+}
+int uiAct_ShowForce(void){
+	
+	uiHelper_DisplayNumeric(&WeldSettings.Force, PSTR("N "), 2);
+	return 0;
+	
+}
+//Action to Set the Squeeze Time
+int uiAct_SetSqueezeTime(void){
+	
+	TempVal = WeldSettings.Squeeze_Time;
+	
+	if( uiHelper_SetNumericParam(&TempVal,
+	_MAXWeldSqueeze_mS,
+	0,
+	_WeldDef_Squeeze,
+	_MINWeldPulseDelay_mS) )
+	{
+		WeldSettings.Squeeze_Time = TempVal;
+		EEQ_UpdateWord(&ee_WELD_SQUEEZE, TempVal);
+	}
+
+	return 0;
+	
+}
+int uiAct_ShowSqueezeTime(void){
+	
+	if(WeldSettings.Squeeze_Time)
+		uiHelper_DisplayNumeric(&WeldSettings.Squeeze_Time, PSTR("ms"), 2);
+	else
+		uiHelper_DisplayNumeric(&WeldSettings.Squeeze_Time, PSTR("ms No Force"), 11);
+	return 0;
+	
+}
+//Action to Set the Hold Time
+int uiAct_SetHoldTime(void){
+	
+	TempVal = WeldSettings.Hold_Time;
+	
+	if( uiHelper_SetNumericParam(&TempVal,
+	_MAXWeldHold_mS,
+	0,
+	_WeldDef_Hold,
+	_MINWeldPulseDelay_mS) )
+	{
+		WeldSettings.Hold_Time = TempVal;
+		EEQ_UpdateWord(&ee_WELD_HOLD, TempVal);
+	}
+
+	return 0;
+	
+}
+int uiAct_ShowHoldTime(void){
+	
+	uiHelper_DisplayNumeric(&WeldSettings.Hold_Time, PSTR("ms"), 2);
+	return 0;
+	
+}
+//Action to Set the Off Time (Repeat)
+int uiAct_SetOffTime(void){
+	
+	TempVal = WeldSettings.Off_Time;
+	
+	if( uiHelper_SetNumericParam(&TempVal,
+	_MAXWeldOff_mS,
+	0,
+	_WeldDef_Off,
+	_MINWeldPulseDelay_mS) )
+	{
+		WeldSettings.Off_Time = TempVal;
+		EEQ_UpdateWord(&ee_WELD_OFF, TempVal);
+	}
+
+	return 0;
+	
+}
+int uiAct_ShowOffTime(void){
+	
+	if(WeldSettings.Trigger == wTrigStitch)
+		uiHelper_DisplayNumeric(&WeldSettings.Off_Time, PSTR("ms Stitch"), 9);
+	else if(WeldSettings.Off_Time)
+		uiHelper_DisplayNumeric(&WeldSettings.Off_Time, PSTR("ms Repeat"), 9);
+	else
+		uiHelper_DisplayNumeric(&WeldSettings.Off_Time, PSTR("ms Single"), 9);
+	return 0;
+	
+}
 //Action to Set Contact trigger threshold
 int uiAct_SetTrigThrsh(void){
 	
@@ -739,7 +1147,7 @@ int uiAct_SetTrigThrsh(void){
 								 16) )
 	{
 		ContactTrigLevel = (TempVal / 16);
-		eeprom_update_byte(&ee_DAC_Setting, ContactTrigLevel);
+		EEQ_UpdateByte(&ee_DAC_Setting, ContactTrigLevel);
 		MCP48_SetValue(ContactTrigLevel, _MCP48_GAIN_2);
 	}
 
@@ -756,6 +1164,71 @@ int uiAct_ShowTrigThrsh(void){
 	
 }
 
+//Auto calibrate the Contact trigger threshold - Probes open, then shorted
+int uiAct_CalTrigThrsh(void){
+	
+	uint8_t OpenCode, ShortCode;
+	
+	UI_ResetInputState(&MySwitchStatus);
+	
+	//Connect the sense circuit (Again before each reading - The weld service runs while waiting)
+	WELD_SetMRelay(1);
+	
+	//Open reading
+	vfdClr();
+	vfdPrintStrXY(PSTR("Probes OPEN...  "), 16, 0, 0, _vfdTHISPage);
+	vfdPrintStrXY(PSTR("GO        Cancel"), 16, 0, 1, _vfdTHISPage);
+	if(uiHelper_WaitButton() != 1){
+		WELD_SetMRelay(0);
+		vfdClr();
+		return 0;
+	}
+	WELD_SetMRelay(1);
+	while(WELD_GetMRelay() != MRelay_Closed);
+	OpenCode = WELD_SenseSAR();
+	
+	//Shorted reading
+	vfdPrintStrXY(PSTR("Probes SHORTED.."), 16, 0, 0, _vfdTHISPage);
+	if(uiHelper_WaitButton() != 1){
+		WELD_SetMRelay(0);
+		vfdClr();
+		return 0;
+	}
+	WELD_SetMRelay(1);
+	while(WELD_GetMRelay() != MRelay_Closed);
+	ShortCode = WELD_SenseSAR();
+	
+	WELD_SetMRelay(0);
+	vfdClr();
+	
+	//Need a clear gap to put the threshold in (Below the fitted probe's ID band)
+	if(OpenCode > PROBE_GetMaxTrigLevel()) OpenCode = PROBE_GetMaxTrigLevel();
+	if( (OpenCode < ShortCode) || ((OpenCode - ShortCode) < _TRIGCAL_MIN_SPAN) ){
+		vfdPrintStrXY(PSTR(" Cal Failed -   "), 16, 0, 0, _vfdTHISPage);
+		vfdPrintStrXY(PSTR(" Check Probes!  "), 16, 0, 1, _vfdTHISPage);
+		Beep(500);
+		_delay_ms(uiViewDelayMS);
+		vfdClr();
+		return (-1);
+	}
+	
+	//Set and save the threshold
+	ContactTrigLevel = ShortCode + (uint8_t)(((uint16_t)(OpenCode - ShortCode) * _TRIGCAL_FRACTION_PCT) / 100);
+	EEQ_UpdateByte(&ee_DAC_Setting, ContactTrigLevel);
+	MCP48_SetValue(ContactTrigLevel, _MCP48_GAIN_2);
+	
+	//Show it
+	TempVal = (uint16_t)(16 * ContactTrigLevel);
+	memset((void*)DispValue, 0x20, 16);
+	memcpy_P((void*)DispValue, PSTR("Trig Level    mV"), 16);
+	uiHelper_FormatNumber(&DispValue[10], TempVal, 4);
+	vfdCopyStr(DispValue, 16, 0, 0);
+	_delay_ms(uiViewDelayMS);
+	vfdClr();
+	
+	return 0;
+}
+
 //Action to set defaults
 int uiAct_RestoreDefaults(void){
 	
@@ -767,6 +1240,26 @@ int uiAct_RestoreDefaults(void){
 	WeldSettings.Trig_Delay = _WeldDef_TrigDel;
 	WeldSettings.Trigger = wTrigFootSwitch;
 	WeldSettings.Type = wTypeContinuous;
+	WeldSettings.Force = _WeldDef_Force;
+	WeldSettings.Squeeze_Time = _WeldDef_Squeeze;
+	WeldSettings.Hold_Time = _WeldDef_Hold;
+	WeldSettings.Off_Time = _WeldDef_Off;
+	WeldSettings.Energy = _WeldDef_Energy;
+	WeldSettings.Current = _WeldDef_Current;
+	
+	//Save them (Written in the background)
+	EEQ_UpdateWord(&ee_WELD_P0_LENGTH, WeldSettings.P0_Length);
+	EEQ_UpdateWord(&ee_WELD_P1_LENGTH, WeldSettings.P1_Length);
+	EEQ_UpdateWord(&ee_WELD_IP_DELAY, WeldSettings.IP_Delay);
+	EEQ_UpdateWord(&ee_WELD_TRIG_DELAY, WeldSettings.Trig_Delay);
+	EEQ_UpdateWord(&ee_WELD_TRIGGER, (uint16_t)WeldSettings.Trigger);
+	EEQ_UpdateWord(&ee_WELD_TYPE, (uint16_t)WeldSettings.Type);
+	EEQ_UpdateWord(&ee_WELD_FORCE_N, WeldSettings.Force);
+	EEQ_UpdateWord(&ee_WELD_SQUEEZE, WeldSettings.Squeeze_Time);
+	EEQ_UpdateWord(&ee_WELD_HOLD, WeldSettings.Hold_Time);
+	EEQ_UpdateWord(&ee_WELD_OFF, WeldSettings.Off_Time);
+	EEQ_UpdateWord(&ee_WELD_ENERGY_J, WeldSettings.Energy);
+	EEQ_UpdateWord(&ee_WELD_CURRENT_A, WeldSettings.Current);
 	
 	vfdClr();
 	vfdPrintStrXY(PSTR(" Defaults  Set! "), 16, 0, 0, _vfdTHISPage);
@@ -776,3 +1269,442 @@ int uiAct_RestoreDefaults(void){
 	return 0;
 }
 
+//Browse the weld log - Encoder scrolls, any button exits
+int uiAct_ShowWeldLog(void){
+	
+	wlog_rec_s_t Rec;
+	uint8_t Age = 0;
+	uint8_t Redraw = 1;
+	
+	UI_ResetInputState(&MySwitchStatus);
+	
+	//Anything to show?
+	if(!WLOG_GetRecordCount()){
+		vfdClr();
+		vfdPrintStrXY(PSTR("  Log is Empty  "), 16, 0, 0, _vfdTHISPage);
+		_delay_ms(uiViewDelayMS);
+		vfdClr();
+		return 0;
+	}
+	
+	vfdClr();
+	
+	//Browse loop
+	while(1){
+		//Check switch States
+		UI_ProcessInput(&MySwitchStatus);
+		//Draw the record 
+		if(Redraw){
+			WLOG_GetRecord(Age, &Rec);
+			//First line: Age, Type, Trigger and Fault
+			memset((void*)DispValue, 0x20, 16);
+			DispValue[0] = '-';
+			uiHelper_FormatNumber(&DispValue[1], Age, 2);
+			switch(Rec.Mode & 0x0f){
+				case wTypeContinuous:	memcpy_P((void*)&DispValue[4], PSTR("MAN"), 3); break;
+				case wTypeSinglePulse:	memcpy_P((void*)&DispValue[4], PSTR("1_P"), 3); break;
+				case wTypeDoublePulse:	memcpy_P((void*)&DispValue[4], PSTR("2_P"), 3); break;
+				case wTypeCapDischarge:	memcpy_P((void*)&DispValue[4], PSTR("CD "), 3); break;
+				case wTypeEnergy:		memcpy_P((void*)&DispValue[4], PSTR("NRG"), 3); break;
+				case wTypeConstCurrent:	memcpy_P((void*)&DispValue[4], PSTR("CC "), 3); break;
+				default:				memcpy_P((void*)&DispValue[4], PSTR("???"), 3);
+			}
+			memcpy_P((void*)&DispValue[8], uiHelper_TrigNames(Rec.Mode >> 4)->Code, 2);
+			if(Rec.Fault == wFaultNone){
+				//No fault - Show the quality verdict
+				switch(Rec.Quality){
+					case wQualCold:			memcpy_P((void*)&DispValue[12], PSTR("CL"), 2); break;
+					case wQualExpulsion:	memcpy_P((void*)&DispValue[12], PSTR("EX"), 2); break;
+					default:				memcpy_P((void*)&DispValue[12], PSTR("OK"), 2);
+				}
+			}else{
+				DispValue[11] = 'F';
+				DispValue[12] = ':';
+				uiHelper_FormatNumber(&DispValue[13], Rec.Fault, 2);
+			}
+			vfdCopyStr(DispValue, 16, 0, 0);
+			//Second line: Pulse lengths (mS) and latency (mS)
+			memset((void*)DispValue, 0x20, 16);
+			uiHelper_FormatNumber(&DispValue[0], (uint32_t)Rec.P0 * _MS_PER_WELDTICK, 5);
+			DispValue[5] = '/';
+			uiHelper_FormatNumber(&DispValue[6], (uint32_t)Rec.P1 * _MS_PER_WELDTICK, 5);
+			DispValue[11] = 'L';
+			if(Rec.Latency == 0xffff)
+				memcpy_P((void*)&DispValue[12], PSTR("----"), 4);
+			else
+				uiHelper_FormatNumber(&DispValue[12], Rec.Latency / 10, 4);
+			vfdCopyStr(DispValue, 16, 0, 1);
+			Redraw = 0;
+		}
+		//check encoder - scroll through log
+		if(MySwitchStatus.encChange == SW_IsChange){
+			if(MySwitchStatus.encCount >= 1){
+				//CW - Older
+				if(MySwitchStatus.encDirection == ENC_DIR_A){
+					if((Age + 1) < WLOG_GetRecordCount()) Age++;
+				}
+				//CCW - Newer
+				if(MySwitchStatus.encDirection == ENC_DIR_B){
+					if(Age) Age--;
+				}
+				Redraw = 1;
+			}
+			//Reset status
+			UI_ResetInputState(&MySwitchStatus);
+		}
+		//Check switch - Any press exits
+		if(MySwitchStatus.swChange == SW_IsChange){
+			if( (MySwitchStatus.swA_Duration) ||
+			    (MySwitchStatus.swB_Duration) ||
+				(MySwitchStatus.swC_Duration) ) break;
+			//Reset status
+			UI_ResetInputState(&MySwitchStatus);
+		}
+	}
+	
+	UI_ResetInputState(&MySwitchStatus);
+	UI_ResetActivity();
+	vfdClr();
+	
+	return 0;
+}
+
+//Show the Lifetime and Shift counts and the weld rate
+int uiAct_ShowCounters(void){
+	
+	vfdClr();
+	//Lifetime count
+	memset((void*)DispValue, 0x20, 16);
+	memcpy_P((void*)DispValue, PSTR("Life"), 4);
+	uiHelper_FormatNumber(&DispValue[5], WLOG_GetLifetimeCount(), 11);
+	vfdCopyStr(DispValue, 16, 0, 0);
+	//Shift count and welds per minute 
+	memset((void*)DispValue, 0x20, 16);
+	memcpy_P((void*)DispValue, PSTR("Shft"), 4);
+	uiHelper_FormatNumber(&DispValue[4], WLOG_GetShiftCount(), 6);
+	uiHelper_FormatNumber(&DispValue[11], WLOG_GetRate(), 3);
+	memcpy_P((void*)&DispValue[14], PSTR("/m"), 2);
+	vfdCopyStr(DispValue, 16, 0, 1);
+	
+	_delay_ms(uiViewDelayMS);
+	
+	UI_ResetActivity();
+	
+	vfdClr();
+	
+	return 0;
+}
+
+//Start a new shift (Resets the shift count)
+int uiAct_ResetShift(void){
+	
+	UI_ResetInputState(&MySwitchStatus);
+	
+	WLOG_ResetShift();
+	
+	vfdClr();
+	vfdPrintStrXY(PSTR("Shift Count Rst!"), 16, 0, 0, _vfdTHISPage);
+	_delay_ms(uiSaveDelayMS);
+	vfdClr();
+	
+	return 0;
+}
+
+//Put the name of a reset cause (MCUSR flags) in Dest (3 chars)
+void uiHelper_ResetCauseStr(char* Dest, uint8_t Cause){
+	
+	if(Cause & _BV(WDRF))		memcpy_P((void*)Dest, PSTR("WDT"), 3);
+	else if(Cause & _BV(BORF))	memcpy_P((void*)Dest, PSTR("BOD"), 3);
+	else if(Cause & _BV(EXTRF))	memcpy_P((void*)Dest, PSTR("EXT"), 3);
+	else if(Cause & _BV(JTRF))	memcpy_P((void*)Dest, PSTR("JTG"), 3);
+	else if(Cause & _BV(PORF))	memcpy_P((void*)Dest, PSTR("PWR"), 3);
+	else						memcpy_P((void*)Dest, PSTR("???"), 3);
+}
+
+//Browse the trace saved before the last reset - Encoder scrolls, any button exits
+int uiAct_ShowTrace(void){
+	
+	trace_ring_s_t Info;
+	trace_entry_s_t Entry;
+	uint8_t Age = 0;
+	uint8_t Redraw = 1;
+	
+	UI_ResetInputState(&MySwitchStatus);
+	
+	//Anything to show?
+	if(!TRACE_GetSnapshotEntry(0, &Entry)){
+		vfdClr();
+		vfdPrintStrXY(PSTR(" No Trace Saved "), 16, 0, 0, _vfdTHISPage);
+		_delay_ms(uiViewDelayMS);
+		vfdClr();
+		return 0;
+	}
+	TRACE_GetSnapshotInfo(&Info);
+	
+	vfdClr();
+	
+	//Browse loop
+	while(1){
+		//Check switch States
+		UI_ProcessInput(&MySwitchStatus);
+		//Draw the entry 
+		if(Redraw){
+			TRACE_GetSnapshotEntry(Age, &Entry);
+			//First line: Age, Reset cause and overrun flags
+			memset((void*)DispValue, 0x20, 16);
+			DispValue[0] = '-';
+			uiHelper_FormatNumber(&DispValue[1], Age, 2);
+			uiHelper_ResetCauseStr(&DispValue[5], Info.Cause);
+			memcpy_P((void*)&DispValue[10], PSTR("OVR"), 3);
+			uiHelper_FormatNumber(&DispValue[13], Info.Overrun, 3);
+			vfdCopyStr(DispValue, 16, 0, 0);
+			//Second line: Timestamp (10mS), Event and Data
+			memset((void*)DispValue, 0x20, 16);
+			uiHelper_FormatNumber(&DispValue[0], Entry.TS, 5);
+			switch(Entry.Event){
+				case TrcEvt_Reset:		memcpy_P((void*)&DispValue[6], PSTR("RESET"), 5); break;
+				case TrcEvt_WeldStage:	memcpy_P((void*)&DispValue[6], PSTR("STAGE"), 5); break;
+				case TrcEvt_Trigger:	memcpy_P((void*)&DispValue[6], PSTR("TRIG "), 5); break;
+				case TrcEvt_ZeroXLost:	memcpy_P((void*)&DispValue[6], PSTR("ZX-LO"), 5); break;
+				case TrcEvt_ZeroXFound:	memcpy_P((void*)&DispValue[6], PSTR("ZX-OK"), 5); break;
+				case TrcEvt_Overrun:	memcpy_P((void*)&DispValue[6], PSTR("OVRUN"), 5); break;
+				case TrcEvt_Fault:		memcpy_P((void*)&DispValue[6], PSTR("FAULT"), 5); break;
+				case TrcEvt_Ready:		memcpy_P((void*)&DispValue[6], PSTR("READY"), 5); break;
+				case TrcEvt_Probe:		memcpy_P((void*)&DispValue[6], PSTR("PROBE"), 5); break;
+				case TrcEvt_LogDrop:	memcpy_P((void*)&DispValue[6], PSTR("LGDRP"), 5); break;
+				default:				memcpy_P((void*)&DispValue[6], PSTR("?????"), 5);
+			}
+			uiHelper_FormatNumber(&DispValue[13], Entry.Data, 3);
+			vfdCopyStr(DispValue, 16, 0, 1);
+			Redraw = 0;
+		}
+		//check encoder - scroll through trace
+		if(MySwitchStatus.encChange == SW_IsChange){
+			if(MySwitchStatus.encCount >= 1){
+				//CW - Older
+				if(MySwitchStatus.encDirection == ENC_DIR_A){
+					if(TRACE_GetSnapshotEntry(Age + 1, &Entry)) Age++;
+				}
+				//CCW - Newer
+				if(MySwitchStatus.encDirection == ENC_DIR_B){
+					if(Age) Age--;
+				}
+				Redraw = 1;
+			}
+			//Reset status
+			UI_ResetInputState(&MySwitchStatus);
+		}
+		//Check switch - Any press exits
+		if(MySwitchStatus.swChange == SW_IsChange){
+			if( (MySwitchStatus.swA_Duration) ||
+			    (MySwitchStatus.swB_Duration) ||
+				(MySwitchStatus.swC_Duration) ) break;
+			//Reset status
+			UI_ResetInputState(&MySwitchStatus);
+		}
+	}
+	
+	UI_ResetInputState(&MySwitchStatus);
+	UI_ResetActivity();
+	vfdClr();
+	
+	return 0;
+}
+
+//Show the diagnostics pages - Encoder scrolls, any button exits
+int uiAct_ShowDiagnostics(void){
+	
+	uint8_t Page = 0;
+	uint8_t Redraw = 1;
+	uint32_t TempVal, LastDraw = 0;
+	
+	UI_ResetInputState(&MySwitchStatus);
+	
+	vfdClr();
+	
+	//Browse loop
+	while(1){
+		//Check switch States
+		UI_ProcessInput(&MySwitchStatus);
+		//Keep live values up to date
+		if((GetSysTicks() - LastDraw) > (uiDiagRefreshMS / _MS_PER_SYSTICK)) Redraw = 1;
+		//Draw the page 
+		if(Redraw){
+			LastDraw = GetSysTicks();
+			memset((void*)DispValue, 0x20, 16);
+			switch(Page){
+				//Reset cause and ISR Overrun flags
+				case 0:
+					memcpy_P((void*)DispValue, PSTR("Reset"), 5);
+					uiHelper_ResetCauseStr(&DispValue[13], TRACE_GetResetCause());
+					vfdCopyStr(DispValue, 16, 0, 0);
+					memset((void*)DispValue, 0x20, 16);
+					memcpy_P((void*)DispValue, PSTR("ISR Overrun"), 11);
+					uiHelper_FormatNumber(&DispValue[13], TRACE_GetOverrun(), 3);
+					break;
+				//Boot to ready time (mS)
+				case 1:
+					memcpy_P((void*)DispValue, PSTR("Boot to Ready"), 13);
+					vfdCopyStr(DispValue, 16, 0, 0);
+					memset((void*)DispValue, 0x20, 16);
+					TempVal = WELD_GetBootReadyTime();
+					uiHelper_FormatNumber(&DispValue[4], TempVal / 1000, 6);
+					DispValue[10] = '.';
+					uiHelper_FormatNumber(&DispValue[11], (TempVal % 1000) / 100, 1);
+					memcpy_P((void*)&DispValue[13], PSTR("mS"), 2);
+					break;
+				//Analog inputs at the pins (mV)
+				case 2:
+					memcpy_P((void*)DispValue, PSTR(" Cap  Cur  Line "), 16);
+					vfdCopyStr(DispValue, 16, 0, 0);
+					memset((void*)DispValue, 0x20, 16);
+					uiHelper_FormatNumber(&DispValue[0], ADC_GetMillivolts(_ADC_CH_VCAP), 5);
+					uiHelper_FormatNumber(&DispValue[5], ADC_GetMillivolts(_ADC_CH_ISENSE), 5);
+					uiHelper_FormatNumber(&DispValue[10], ADC_GetMillivolts(_ADC_CH_VLINE), 5);
+					break;
+				//Line voltage (RMS) and the compensation on the last weld
+				case 3:
+					memcpy_P((void*)DispValue, PSTR("Line RMS     V"), 14);
+					uiHelper_FormatNumber(&DispValue[9], WELD_GetLineVoltage(), 4);
+					vfdCopyStr(DispValue, 16, 0, 0);
+					memset((void*)DispValue, 0x20, 16);
+					memcpy_P((void*)DispValue, PSTR("Comp         %"), 14);
+					uiHelper_FormatNumber(&DispValue[9], WELD_GetLineComp(), 4);
+					break;
+				//Contact resistance and the heat picked for it
+				case 4:
+					memcpy_P((void*)DispValue, PSTR("Contact     mOhm"), 16);
+					if(WELD_GetContactR() == 0xffff)
+						memcpy_P((void*)&DispValue[8], PSTR("OPEN"), 4);
+					else
+						uiHelper_FormatNumber(&DispValue[8], WELD_GetContactR(), 4);
+					vfdCopyStr(DispValue, 16, 0, 0);
+					memset((void*)DispValue, 0x20, 16);
+					memcpy_P((void*)DispValue, PSTR("Heat         %"), 14);
+					uiHelper_FormatNumber(&DispValue[9], WELD_GetContactHeat(), 4);
+					break;
+				//Contact chatter on the last touch
+				case 5:
+					memcpy_P((void*)DispValue, PSTR("Bounces"), 7);
+					uiHelper_FormatNumber(&DispValue[13], WELD_GetChatter(&TempVal), 3);
+					vfdCopyStr(DispValue, 16, 0, 0);
+					memset((void*)DispValue, 0x20, 16);
+					memcpy_P((void*)DispValue, PSTR("Max Gap       uS"), 16);
+					uiHelper_FormatNumber(&DispValue[8], TempVal, 6);
+					break;
+				//Trigger to fire latency of the last weld, and how much was over the set delay
+				case 6:
+					TempVal = WELD_GetLastLatency();
+					memcpy_P((void*)DispValue, PSTR("Latency       uS"), 16);
+					if(TempVal == 0xffffffff)
+						memcpy_P((void*)&DispValue[9], PSTR("----"), 4);
+					else
+						uiHelper_FormatNumber(&DispValue[8], (TempVal > 999999) ? 999999 : TempVal, 6);
+					vfdCopyStr(DispValue, 16, 0, 0);
+					memset((void*)DispValue, 0x20, 16);
+					memcpy_P((void*)DispValue, PSTR("Over Dly      uS"), 16);
+					if( (TempVal != 0xffffffff) && (TempVal >= (WeldSettings.Trig_Delay * 1000UL)) )
+						uiHelper_FormatNumber(&DispValue[8], TempVal - (WeldSettings.Trig_Delay * 1000UL), 6);
+					break;
+				//Electrode force (Force trigger only) and the setpoint
+				case 7:
+					memcpy_P((void*)DispValue, PSTR("Force          N"), 16);
+					if(WeldSettings.Trigger != wTrigForce)
+						memcpy_P((void*)&DispValue[10], PSTR("OFF"), 3);
+					else if(WELD_GetForce() < 0)
+						DispValue[9] = '-';
+					else
+						uiHelper_FormatNumber(&DispValue[9], WELD_GetForce(), 4);
+					vfdCopyStr(DispValue, 16, 0, 0);
+					memset((void*)DispValue, 0x20, 16);
+					memcpy_P((void*)DispValue, PSTR("Setpoint       N"), 16);
+					uiHelper_FormatNumber(&DispValue[9], WeldSettings.Force, 4);
+					break;
+				case 8:
+					memcpy_P((void*)DispValue, PSTR("Probe ID        "), 16);
+					uiHelper_FormatNumber(&DispValue[13], PROBE_GetID(), 3);
+					vfdCopyStr(DispValue, 16, 0, 0);
+					memset((void*)DispValue, 0x20, 16);
+					memcpy_P((void*)DispValue, PSTR("Open Code       "), 16);
+					uiHelper_FormatNumber(&DispValue[13], PROBE_GetLastCode(), 3);
+					break;
+			}
+			vfdCopyStr(DispValue, 16, 0, 1);
+			Redraw = 0;
+		}
+		//check encoder - scroll through pages
+		if(MySwitchStatus.encChange == SW_IsChange){
+			if(MySwitchStatus.encCount >= 1){
+				//CW - Next
+				if(MySwitchStatus.encDirection == ENC_DIR_A){
+					if((Page + 1) < uiDiagPages) Page++;
+				}
+				//CCW - Previous
+				if(MySwitchStatus.encDirection == ENC_DIR_B){
+					if(Page) Page--;
+				}
+				vfdClr();
+				Redraw = 1;
+			}
+			//Reset status
+			UI_ResetInputState(&MySwitchStatus);
+		}
+		//Check switch - Any press exits
+		if(MySwitchStatus.swChange == SW_IsChange){
+			if( (MySwitchStatus.swA_Duration) ||
+			    (MySwitchStatus.swB_Duration) ||
+				(MySwitchStatus.swC_Duration) ) break;
+			//Reset status
+			UI_ResetInputState(&MySwitchStatus);
+		}
+	}
+	
+	UI_ResetInputState(&MySwitchStatus);
+	UI_ResetActivity();
+	vfdClr();
+	
+	return 0;
+}
+
+//Send the contact chatter record out of the serial port (Oldest edge first)
+int uiAct_DumpChatter(void){
+	
+	chatter_s_t Edge;
+	uint32_t MaxGap, Last = 0;
+	uint8_t Age;
+	
+	SER_PutStr_P(PSTR("Contact chatter"));
+	SER_NewLine();
+	SER_PutStr_P(PSTR("Bounces: "));
+	SER_PutNumber(WELD_GetChatter(&MaxGap));
+	SER_NewLine();
+	SER_PutStr_P(PSTR("Max gap uS: "));
+	SER_PutNumber(MaxGap);
+	SER_NewLine();
+	SER_PutStr_P(PSTR("Edges: "));
+	SER_PutNumber(WELD_GetContactEdges());
+	SER_NewLine();
+	
+	//Edge, time (uS), and time since the edge before
+	for(Age = _CHATTER_LEN; Age; Age--){
+		if(!WELD_GetChatterEdge(Age - 1, &Edge)) continue;
+		SER_PutChar(Edge.Made ? 'M' : 'B');
+		SER_PutChar(' ');
+		SER_PutNumber(Edge.US);
+		if(Last){
+			SER_PutStr_P(PSTR(" +"));
+			SER_PutNumber(Edge.US - Last);
+		}
+		Last = Edge.US;
+		SER_NewLine();
+	}
+	//Hand TXD back to the load cell
+	SER_Release();
+	
+	vfdClr();
+	vfdPrintStrXY(PSTR(" Sent to Serial "), 16, 0, 0, _vfdTHISPage);
+	_delay_ms(uiSaveDelayMS);
+	vfdClr();
+	
+	return 0;
+}
@@ -42,7 +42,16 @@
 //UI Action Defines
 #define uiViewDelayMS		2000
 #define uiSaveDelayMS		500
+#define uiDiagPages			9
+#define uiDiagRefreshMS		250
+#define uiNumTrigs			5			//Trigger types (weldtrigger_e_t), one uiTrigNames_s_t each
 
+//Trigger names (In program memory, indexed by weldtrigger_e_t)
+typedef struct uiTrigNames_s_t
+{
+	char Name[16];						//Menu text
+	char Code[2];						//Short code for the home screen and weld log
+}uiTrigNames_s_t;
 
 //UI Helper functions *********************************************************
 //UI Menu initializer
@@ -51,6 +60,14 @@ int uiHelper_LoadMenus(void);
 int uiHelper_SetNumericParam(void* Param, uint16_t uBound, uint16_t lBound, uint16_t dVal, uint8_t increment);
 //Generic Value Display Routine 
 void uiHelper_DisplayNumeric(void* Param, const char* Units, uint8_t lenUnits);
+//Wait for a button press: 1 = SW A, 2 = SW B, 3 = Both, 0 = Timed out (No input for _UI_ACT_TIMEOUT_MS)
+uint8_t uiHelper_WaitButton(void);
+//Write a number into a string, right justified in Width characters
+void uiHelper_FormatNumber(char* Dest, uint32_t Val, uint8_t Width);
+//Put the name of a reset cause (MCUSR flags) in Dest (3 chars)
+void uiHelper_ResetCauseStr(char* Dest, uint8_t Cause);
+//Get the names of a trigger type (Program memory - unknown types are the foot switch)
+const uiTrigNames_s_t* uiHelper_TrigNames(uint8_t Trigger);
 
 //UI Action function Definitions **********************************************
 //Each menu requires at least one action 
@@ -73,11 +90,42 @@ int uiAct_ShowTrigType(void);
 //Action to Set Weld Type
 int uiAct_SetWeldType(void);
 int uiAct_ShowWeldType(void);
+//Action to Set the Capacitor Discharge Voltage
+int uiAct_SetVoltage(void);
+int uiAct_ShowVoltage(void);
+//Action to Set the Energy Target
+int uiAct_SetEnergy(void);
+int uiAct_ShowEnergy(void);
+//Action to Set the Current Target
+int uiAct_SetCurrent(void);
+int uiAct_ShowCurrent(void);
+//Action to Set the Force Trigger Setpoint
+int uiAct_SetForce(void);
+int uiAct_ShowForce(void);
+//Action to Set the Squeeze Time
+int uiAct_SetSqueezeTime(void);
+int uiAct_ShowSqueezeTime(void);
+//Action to Set the Hold Time
+int uiAct_SetHoldTime(void);
+int uiAct_ShowHoldTime(void);
+//Action to Set the Off Time (Repeat)
+int uiAct_SetOffTime(void);
+int uiAct_ShowOffTime(void);
 //Action to Set Contact trigger threshold
 int uiAct_SetTrigThrsh(void);
 int uiAct_ShowTrigThrsh(void);
+//Action to auto calibrate the Contact trigger threshold
+int uiAct_CalTrigThrsh(void);
 //Action to set defaults
 int uiAct_RestoreDefaults(void);
+//Actions for the Weld Counters and Log
+int uiAct_ShowWeldLog(void);
+int uiAct_ShowCounters(void);
+int uiAct_ResetShift(void);
+//Actions for the Diagnostics
+int uiAct_ShowTrace(void);
+int uiAct_ShowDiagnostics(void);
+int uiAct_DumpChatter(void);
 
 
 
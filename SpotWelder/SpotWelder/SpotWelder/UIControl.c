@@ -262,6 +262,12 @@ int uiObj_Activate(UIObjHandle Handle){
 	return retVal;
 
 }
+
+//Get the active UI Object's Handle
+UIObjHandle uiObj_GetActive(void){
+	
+	return CurrentUIObj;
+}
 //Draw a UI Objects Previous menu (On Left)
 int uiObj_DrawPrev(UIObjHandle Handle){
 	
@@ -624,7 +630,7 @@ void UI_Service(void){
 		
 	}else{
 		
-		//Are we in Undefined Screen?
+		//Are we in Undefined Screen? (Title screen at start up)
 		if(CurrentUIObj == _uiObjVoidHandle){
 			if(!MenuIsDrawn){
 				if(Activity){
@@ -633,8 +639,30 @@ void UI_Service(void){
 					vfdPrintStrXY(FWVerMsg, 16, 0, 1, _vfdTHISPage);
 				}
 				MenuIsDrawn = 1;
-				//Disable welding
+				//Save time stamp
+				LastInput = GetSysTicks();
+			}
+			//Welding is ready while the title is shown
+			EnableWeld();
+			//Check for Buttons or Encoder - Go to the first menu
+			if((InputStates.encChange) || (InputStates.swChange)){
+				//Reset Input state
+				UI_ResetInputState(&InputStates);
+				//Disable Welding
 				DisableWeld();
+				//Activate The First Menu
+				uiObj_Activate(1);
+				//Reset input time stamp 
+				LastInput = GetSysTicks();
+				//Reset Activity 
+				UI_ResetActivity();
+			}else{
+				//Title timed out - Show Home Screen
+				if((GetSysTicks() - LastInput) > (_UI_SPLASH_TIME_MS / _MS_PER_SYSTICK) ){
+					vfdClr();
+					uiObj_Activate(_uiObjHomeHandle);
+					UpdateHome = 1;
+				}
 			}
 		}
 		//Are we in Home Screen?
@@ -769,13 +797,115 @@ void UI_Status(uint8_t Update){
 			}
 		}
 		
-		//Show Trigger Setting
-		if(WeldSettings.Trigger == wTrigContact){
-			vfdPrintStrXY(PSTR("CT"),2 ,6 ,1, _vfdTHISPage);
-		}else{
-			vfdPrintStrXY(PSTR("FS"),2 ,6, 1, _vfdTHISPage);
+		//Constant Current Weld
+		if(WeldSettings.Type == wTypeConstCurrent){
+			//Waiting	
+			if( (CurWeldStage == WeldStage_Wait) ){
+				if(IsWeldEnabled()){
+					//Ready to run 
+					switch (trigd){
+						case 0:
+							vfdPrintStrXY(PSTR(" CC        RDY! "), 16, 0, 1, _vfdTHISPage);
+							break;
+						case 1:
+						case 2:
+							vfdPrintStrXY(PSTR(" CC      TRIG'D "), 16, 0, 1, _vfdTHISPage);
+							break;
+					}
+				}else{
+					vfdPrintStrXY(PSTR(" CC    DISABLED "), 16, 0, 1, _vfdTHISPage);
+				}
+			//Running
+			}else{
+				
+				if(CurWeldStage == WeldStage_End)
+					vfdPrintStrXY(PSTR(" CC        WAIT "), 16, 0, 1, _vfdTHISPage);
+				else
+					vfdPrintStrXY(PSTR(" CC        RUN  "), 16, 0, 1, _vfdTHISPage);
+			}
+		}
+		
+		//Energy Terminated Weld
+		if(WeldSettings.Type == wTypeEnergy){
+			//Waiting	
+			if( (CurWeldStage == WeldStage_Wait) ){
+				if(IsWeldEnabled()){
+					//Ready to run 
+					switch (trigd){
+						case 0:
+							vfdPrintStrXY(PSTR(" NRG       RDY! "), 16, 0, 1, _vfdTHISPage);
+							break;
+						case 1:
+						case 2:
+							vfdPrintStrXY(PSTR(" NRG     TRIG'D "), 16, 0, 1, _vfdTHISPage);
+							break;
+					}
+				}else{
+					vfdPrintStrXY(PSTR(" NRG   DISABLED "), 16, 0, 1, _vfdTHISPage);
+				}
+			//Running
+			}else{
+				
+				if(CurWeldStage == WeldStage_End)
+					vfdPrintStrXY(PSTR(" NRG       WAIT "), 16, 0, 1, _vfdTHISPage);
+				else
+					vfdPrintStrXY(PSTR(" NRG       RUN  "), 16, 0, 1, _vfdTHISPage);
+			}
 		}
 		
+		//Capacitor Discharge Weld
+		if(WeldSettings.Type == wTypeCapDischarge){
+			//Waiting	
+			if( (CurWeldStage == WeldStage_Wait) ){
+				if(IsWeldEnabled()){
+					//Ready to run once charged
+					switch (trigd){
+						case 0:
+							if(WELD_IsCharged())
+								vfdPrintStrXY(PSTR(" CD        RDY! "), 16, 0, 1, _vfdTHISPage);
+							else
+								vfdPrintStrXY(PSTR(" CD        CHG. "), 16, 0, 1, _vfdTHISPage);
+							break;
+						case 1:
+						case 2:
+							vfdPrintStrXY(PSTR(" CD      TRIG'D "), 16, 0, 1, _vfdTHISPage);
+							break;
+					}
+				}else{
+					vfdPrintStrXY(PSTR(" CD    DISABLED "), 16, 0, 1, _vfdTHISPage);
+				}
+			//Running
+			}else{
+				
+				if(CurWeldStage == WeldStage_End)
+					vfdPrintStrXY(PSTR(" CD        WAIT "), 16, 0, 1, _vfdTHISPage);
+				else
+					vfdPrintStrXY(PSTR(" CD        RUN  "), 16, 0, 1, _vfdTHISPage);
+			}
+		}
+		
+		//Last weld misfired or was refused? Show it until the next weld
+		if( (CurWeldStage == WeldStage_Wait) && (trigd == 0) && IsWeldEnabled() ){
+			if(WELD_GetLastFault() == wFaultMisfire)
+				vfdPrintStrXY(PSTR("MISF! "), 6, 10, 1, _vfdTHISPage);
+			if(WELD_GetLastFault() == wFaultContactR)
+				vfdPrintStrXY(PSTR("HI-R! "), 6, 10, 1, _vfdTHISPage);
+			if(WELD_GetLastFault() == wFaultNone){
+				if(WELD_GetLastQuality() == wQualCold)
+					vfdPrintStrXY(PSTR("COLD! "), 6, 10, 1, _vfdTHISPage);
+				if(WELD_GetLastQuality() == wQualExpulsion)
+					vfdPrintStrXY(PSTR("EXPL! "), 6, 10, 1, _vfdTHISPage);
+			}
+		}
+		
+		//Good weld? Say so while waiting for the next one
+		if( (CurWeldStage == WeldStage_End) && (WELD_GetLastFault() == wFaultNone) &&
+		    (WELD_GetLastQuality() == wQualGood) )
+			vfdPrintStrXY(PSTR("GOOD  "), 6, 10, 1, _vfdTHISPage);
+		
+		//Show Trigger Setting
+		vfdPrintStrXY(uiHelper_TrigNames(WeldSettings.Trigger)->Code, 2, 6, 1, _vfdTHISPage);
+		
 		LastWeldStage = CurWeldStage;
 		
 		UI_ResetActivity();
@@ -52,6 +52,7 @@
 //UI Behavior
 #define _UI_MENU_SWEEP_TIME			200
 #define _UI_HOME_TIMEOUT_MS			3000
+#define _UI_SPLASH_TIME_MS			3000
 #define _UI_ACT_TIMEOUT_MS			60000
 #define _UI_SCRSAV_TIME_MS			50
 #define _UI_MIN_FOOTSW_MS			50
@@ -60,7 +61,7 @@
 //Some Constants 
 #define _uiObjHomeHandle			0			//Home Menu - Always Zero
 #define _uiObjVoidHandle			255			//Undefined Menu - Always 255				
-#define _uiMaxMenuObjs				16
+#define _uiMaxMenuObjs				20
 
 //Custom Types for UI control
 typedef enum enc_dir_enum_t
@@ -139,6 +140,8 @@ int uiObj_SetPrev(UIObjHandle Handle, UIObjHandle NewPrev);
 int uiObj_RunAction(UIObjHandle Handle, uint8_t ActionID);
 //Activate a UI Object
 int uiObj_Activate(UIObjHandle Handle);
+//Get the active UI Object's Handle
+UIObjHandle uiObj_GetActive(void);
 //Draw a UI Objects Previous menu (On Left)
 int uiObj_DrawPrev(UIObjHandle Handle);
 //Draw a UI Objects Next Menu (On Right)
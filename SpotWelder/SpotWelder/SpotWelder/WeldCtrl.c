@@ -55,16 +55,105 @@ static volatile uint8_t ZeroXLost = 0;
 static volatile uint8_t ZeroX_Detected = 0; 
 static volatile uint8_t ZeroX_Polarity = 0;
 static volatile uint32_t ZeroX_LastDetectedTS = 0;
+//Weld Log
+static wlog_rec_s_t CurWeldLog;
+static uint8_t WeldLogPending = 0;
+static volatile uint32_t TriggerTS = 0;								//System tick of the trigger (Found from the elapsed uS - GetSysMicros() wraps, the ticks do not)
+static volatile uint32_t TriggerUS = 0;
+static uint32_t ContStartUS = 0;
+static uint32_t LastLatencyUS = 0xffffffff;
+
+//Contact sensing (INT2 edges, or analog comparator edges timestamped by Timer 1 input capture)
+static volatile uint8_t ContactMade = 0;
+static volatile uint32_t ContactMakeUS = 0;
+static volatile uint16_t ContactEdges = 0;
+//Contact chatter record
+static chatter_s_t Chatter[_CHATTER_LEN];
+static uint8_t ChatterIndex = 0;
+static volatile uint8_t ChatterBounces = 0;
+static volatile uint32_t ChatterMaxGap = 0;
+static uint32_t ContactBreakUS = 0;
+
+//Measurement relay sequencing
+static uint8_t MRelayState = MRelay_Open;
+static uint32_t MRelayChangeUS = 0;
+
+//Foot switch (Press edge on INT1, confirmed by the system tick)
+static volatile uint8_t FootState = FootSW_Armed;
+static volatile uint8_t FootDebounce = 0;
+static volatile uint8_t FootPressed = 0;
+static volatile uint32_t FootPressUS = 0;
+
+//Electrode force (Load cell, sampled by the weld service)
+static int32_t ForceZero = 0;
+static uint8_t ForceZeroed = 0;
+static volatile int16_t Force = 0;
+static int16_t ForceRef;
+static uint32_t ForceSinceUS;
+static volatile uint8_t ForceAbove = 0;
+static volatile uint8_t ForceStable = 0;
+static volatile uint32_t ForceStableUS;
+static uint32_t ForceSampleTS;								//Time of the last sample (System ticks)
+
+//Boot to ready time (uS, 0 = Not ready yet)
+static uint32_t BootReadyTime = 0;
+
+//Capacitor bank charged flag
+static volatile uint8_t ChargeReady = 0;
+
+//Fault code and quality verdict of the last weld, and misfire retries used
+static uint8_t LastFault = wFaultNone;
+//Next weld cycle already loaded (Stitch, Contact + Foot switch)
+static uint8_t WeldPreArmed = 0;
+static uint8_t LastQuality = wQualUnknown;
+static uint8_t MisfireRetries = 0;
+static uint8_t MisfireRetry = 0;							//Retry waiting for the inter-weld delay
+
+//Line compensation applied to the last weld (% of the set pulse length)
+static uint8_t LineComp = 100;
+
+//Contact resistance (mOhm) and the heat scale picked for it (%)
+static uint16_t ContactR = 0;
+static uint8_t ContactHeat = 100;
+
+//Contact resistance to heat lookup - higher resistance parts get more heat
+static const crheat_s_t ContactHeatTable[_CR_TABLE_LEN] PROGMEM = {
+	{  20, 100 },
+	{  50, 110 },
+	{ 100, 120 },
+	{ 200, 135 },
+	{ _CR_MAX_mOHM, 150 }
+};
 
 //Macros
 
 //Analog or Terminal detect
+#if defined( _CONTACT_ACIC )
+#define _DisTermDetect		(TIMSK1 &= ~_BV(ICIE1))
+#define _ArmTermDetect		(TIMSK1 |=  _BV(ICIE1))
+#define _TermDetectOn		(TIMSK1 & _BV(ICIE1))
+#define _TermEdgePending	(TIFR1 & _BV(ICF1))
+#define _ClrTermEdge		(TIFR1 = _BV(ICF1))
+//Capture the edge that leaves the state given (Made = catch the rising break)
+#define _TermNextEdge(Made)	((Made) ? (TCCR1B |= _BV(ICES1)) : (TCCR1B &= ~_BV(ICES1)))
+#else
 #define _DisTermDetect		(EIMSK &= ~_BV(INT2))
-#define _EnaTermDetect		(EIMSK |=  _BV(INT2))
+#define _ArmTermDetect		(EIMSK |=  _BV(INT2))
+#define _TermDetectOn		(EIMSK & _BV(INT2))
+#define _TermEdgePending	(EIFR & _BV(INTF2))
+#define _ClrTermEdge		(EIFR = _BV(INTF2))
+//INT2 catches both edges
+#define _TermNextEdge(Made)	((void)(Made))
+#endif
+#define _EnaTermDetect		EnaContactDetect()
 
 //Foot Switch
 #define _DisFootSW			(EIMSK &= ~_BV(INT1))
 #define _EnaFootSW			(EIMSK |=  _BV(INT1))
+#define _FootSWDown			( (FootState == FootSW_Held) && !(_FSWINPINS & _BV(_FSWINPIN)) )
+
+//Minimum latency (No trigger delay) 
+#define _MinLatency			(WeldSettings.Trig_Delay == 0)
 
 //Zero Cross
 #define _DisZeroX			(EIMSK &= ~_BV(INT0))
@@ -73,24 +162,71 @@ static volatile uint32_t ZeroX_LastDetectedTS = 0;
 //Function implementations ****************************************************
 
 //Interrupt Handlers       **********
-//INT2 - Detects 'connected' Weld terminals to automatically trigger 
-//               a weld when this feature is enabled 
-ISR(INT2_vect){
+//Record a contact make (1) or break (0) edge at EdgeUS - Called from the 
+//contact sense interrupt.  The trigger waits for the contact to dwell 
+//(See WELD_Service)
+static inline void ContactEdge(uint8_t Made, uint32_t EdgeUS) __attribute__((always_inline));
+static inline void ContactEdge(uint8_t Made, uint32_t EdgeUS){
 	
-	uint8_t PinState;
-	//Check to make sure switch is pressed still
-	PinState = _CSINPINS & _BV(_CSINPIN);
-	if(!PinState){
-		WeldTriggered = 0;
+	if(!Made){
+		ContactMade = 0;
+		ContactBreakUS = EdgeUS;
 	}else{
-		//rESET aCTIVITY
+		ContactMade = 1;
+		ContactMakeUS = EdgeUS;
+		//Back after a short break is a bounce, otherwise it is a new touch
+		if( ContactBreakUS && ((EdgeUS - ContactBreakUS) < _CHATTER_NEW_TOUCH_US) ){
+			if(ChatterBounces < 0xff) ChatterBounces++;
+			if((EdgeUS - ContactBreakUS) > ChatterMaxGap) ChatterMaxGap = EdgeUS - ContactBreakUS;
+		}else{
+			ChatterBounces = 0;
+			ChatterMaxGap = 0;
+		}
 		UI_ResetActivity();
-		if (WeldEnabled) WeldTriggered = 1;
-		//Disable further Detection for Now
-		_DisTermDetect;
 	}
+	ContactEdges++;
+	
+	//Record it
+	Chatter[ChatterIndex].US = EdgeUS;
+	Chatter[ChatterIndex].Made = ContactMade;
+	ChatterIndex = (ChatterIndex + 1) & (_CHATTER_LEN - 1);
 }
 
+#if defined( _CONTACT_ACIC )
+//Timer 1 Input Capture - The analog comparator (ACIC) detected the weld 
+//               terminals making or breaking contact.  The capture time 
+//               dates the edge
+ISR(TIMER1_CAPT_vect){
+	
+	uint16_t Now, Counts;
+	uint32_t EdgeUS;
+	
+	//Timer 1 counts since the edge (It wraps at OCR1A)
+	Now = TCNT1;
+	Counts = ICR1;
+	Counts = (Now >= Counts) ? (Now - Counts) : (Now + OCR1A + 1 - Counts);
+	EdgeUS = GetSysMicros() - (((uint32_t)Counts * _US_PER_TMR1_COUNT_X9) / 9);
+	
+	//Rising = Electrode voltage above the threshold = Contact broken 
+	ContactEdge(!(TCCR1B & _BV(ICES1)), EdgeUS);
+	
+	//Catch the other edge next (Changing the edge can set the flag)
+	TCCR1B ^= _BV(ICES1);
+	TIFR1 = _BV(ICF1);
+}
+#else
+//INT2 - Detects the weld terminals making or breaking contact (Any edge)
+ISR(INT2_vect){
+	
+	uint8_t Made;
+	
+	Made = _CONTACT_MADE ? 1 : 0;
+	//A pulse too short to see both edges of - Nothing changed
+	if(Made == ContactMade) return;
+	ContactEdge(Made, GetSysMicros());
+}
+#endif
+
 
 
 //Interrupt 0 - Detects Zero Cross to allow proper weld triggering in sync
@@ -114,38 +250,401 @@ ISR(INT0_vect){
 	
 	//Save timestamp of Last detected Zero Cross
 	ZeroX_LastDetectedTS = GetSysTicks();
+	TRACE_ZeroX(ZeroX_LastDetectedTS);
+	
+	//Frame the line voltage measurement
+	ADC_LineZeroX();
+	
+	//Constant current - Set the next firing angle
+	PhaseControlZeroX();
 	
 }
 
-//Interrupt 1 - Detects Foot switch to initiate a weld
+//Interrupt 1 - Foot switch press (Falling edge).  Dates the press and masks 
+//              itself; the system tick confirms it (See WELD_FootSwitchTick)
 ISR(INT1_vect){
-	uint8_t PinState;
-	//Check to make sure switch is pressed still
-	PinState = _FSWINPINS & _BV(_FSWINPIN);
 	
-	if(PinState){
-		WeldTriggered = 0;	
+	FootPressUS = GetSysMicros();
+	FootDebounce = 0;
+	FootState = FootSW_Press;
+	//No more edges until the bouncing is over
+	_DisFootSW;
+	//Reset Activity
+	UI_ResetActivity();
+}
+
+//Private Control Functions 
+//Start watching for contact edges (Does nothing if already watching)
+static void EnaContactDetect(void);
+static void EnaContactDetect(void){
+	
+	if(_TermDetectOn) return;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		//Next edge is the opposite of the state now
+		if(_CONTACT_MADE){
+			_TermNextEdge(1);
+			ContactMade = 1;
+			ContactMakeUS = GetSysMicros();
+		}else{
+			_TermNextEdge(0);
+			ContactMade = 0;
+		}
+		_ClrTermEdge;
+		_ArmTermDetect;
+	}
+}
+
+//Start closing (1) or opening (0) the measurement relay.  Opening also stops 
+//contact detection; closing leaves it to the caller once the relay has settled
+static void MRelayRequest(uint8_t On);
+static void MRelayRequest(uint8_t On){
+	
+	if(On){
+		if( (MRelayState == MRelay_Closing) || (MRelayState == MRelay_Closed) ) return;
+		_MRELAY_ON;
+		MRelayState = MRelay_Closing;
 	}else{
-		//rESET aCTIVITY
-		UI_ResetActivity();
-		
-		//Check to see if Foot SW mode is enabled
-		if(WeldSettings.Trigger == wTrigFootSwitch){
-			//If Yes, Trigger weld
-			if (WeldEnabled) WeldTriggered = 1;
+		_DisTermDetect;
+		if( (MRelayState == MRelay_Opening) || (MRelayState == MRelay_Open) ) return;
+		_MRELAY_OFF;
+		MRelayState = MRelay_Opening;
+	}
+	MRelayChangeUS = GetSysMicros();
+}
+
+//Advance the measurement relay through its settle/release time, returns the state
+static uint8_t MRelayService(void);
+static uint8_t MRelayService(void){
+	
+	uint32_t Elapsed = GetSysMicros() - MRelayChangeUS;
+	
+	if( (MRelayState == MRelay_Closing) && (Elapsed >= (_MRELAY_SETTLE_MS * 1000UL)) ) 
+		MRelayState = MRelay_Closed;
+	if( (MRelayState == MRelay_Opening) && (Elapsed >= (_MRELAY_RELEASE_MS * 1000UL)) ) 
+		MRelayState = MRelay_Open;
+	
+	return MRelayState;
+}
+
+//Get the delay between welds in system ticks
+static uint16_t InterWeldDelay(void);
+static uint16_t InterWeldDelay(void){
+	
+	//Capacitor discharge is paced by the charge instead
+	if(WeldSettings.Type == wTypeCapDischarge) return (_CD_INTERWELD_Delay_mS / _MS_PER_SYSTICK);
+	
+	return (_INTERWELD_Delay_mS / _MS_PER_SYSTICK);
+}
+
+//Load the weld cycle from the settings (mS - StartWeldCycle() converts them)
+static void LoadWeldCycle(void);
+static void LoadWeldCycle(void){
+	
+	CurWeldCycle.Pulse_0_Ticks = WeldSettings.P0_Length;
+	CurWeldCycle.Pulse_1_Ticks = WeldSettings.P1_Length;
+	CurWeldCycle.Delay_0_Ticks = WeldSettings.IP_Delay;
+	CurWeldCycle.Current = WeldSettings.Current;
+#if defined( _FORCE_SOLENOID_FITTED )
+	CurWeldCycle.Squeeze_Ticks = WeldSettings.Squeeze_Time;
+	CurWeldCycle.Hold_Ticks = WeldSettings.Hold_Time;
+#else
+	//No force solenoid - No squeeze or hold
+	CurWeldCycle.Squeeze_Ticks = CurWeldCycle.Hold_Ticks = 0;
+#endif
+	if(WeldSettings.Type == wTypeSinglePulse) CurWeldCycle.Type = WeldType_Single;
+	if(WeldSettings.Type == wTypeDoublePulse) CurWeldCycle.Type = WeldType_Double;
+	if(WeldSettings.Type == wTypeCapDischarge) CurWeldCycle.Type = WeldType_CapDischarge;
+	if(WeldSettings.Type == wTypeEnergy) CurWeldCycle.Type = WeldType_Energy;
+	if(WeldSettings.Type == wTypeConstCurrent) CurWeldCycle.Type = WeldType_ConstCurrent;
+}
+
+//Get the off time before the next stitch (System ticks) 
+//The set off time, but never less than the thermal limit for the last weld's on time
+static uint16_t StitchOffTime(void);
+static uint16_t StitchOffTime(void){
+	
+	uint32_t OnMS, OffMS;
+	
+	//On time of the last weld (As compensated)
+	OnMS = CurWeldCycle.Pulse_0_Ticks;
+	if(CurWeldCycle.Type == WeldType_Double) OnMS += CurWeldCycle.Pulse_1_Ticks;
+	
+	//Thermal limit - Keep the duty cycle down
+	OffMS = (OnMS * (100 - _STITCH_MAX_DUTY_PCT)) / _STITCH_MAX_DUTY_PCT;
+	if(OffMS < _STITCH_MIN_OFF_mS) OffMS = _STITCH_MIN_OFF_mS;
+	if(OffMS < WeldSettings.Off_Time) OffMS = WeldSettings.Off_Time;
+	
+	return (uint16_t)(OffMS / _MS_PER_SYSTICK);
+}
+
+//Measure the contact resistance through the measurement relay (mOhm, 0xffff = Open)
+static uint16_t MeasureContactR(void);
+static uint16_t MeasureContactR(void){
+	
+	uint8_t Code;
+	
+	Code = WELD_SenseSAR();
+	
+	//Full scale - Nothing across the electrodes
+	if(Code == 0xff) return 0xffff;
+	
+	return (uint16_t)(((uint32_t)Code * _CR_MV_PER_DAC * _CR_MOHM_PER_V) / 1000);
+}
+
+//Measure the contacts and pick the heat for them. Returns -1 if out of range
+static int ContactCheck(void);
+static int ContactCheck(void){
+	
+	uint8_t i;
+	
+	ContactHeat = 100;
+	ContactR = MeasureContactR();
+	if(ContactR > _CR_MAX_mOHM) return (-1);
+	
+	for(i = 0; i < _CR_TABLE_LEN; i++){
+		if(ContactR <= pgm_read_word(&ContactHeatTable[i].MaxR_mOhm)){
+			ContactHeat = (uint8_t)pgm_read_word(&ContactHeatTable[i].Heat);
+			break;
 		}
-		
-		//Disable further Detection for Now
-		_DisFootSW;
 	}
+	return 0;
+}
+
+//Get a weld current threshold as ISENSE (Raw)
+static uint16_t CurrentThreshold(uint16_t Amps);
+static uint16_t CurrentThreshold(uint16_t Amps){
+	
+	//mV at the pin, then raw counts
+	return (uint16_t)((((uint32_t)Amps * 1000 / _ISENSE_A_PER_V) << 10) / ADC_GetAREF());
+}
+
+//Start a Weld Log entry for the weld about to be fired
+static void WeldLogStart(void);
+static void WeldLogStart(void){
+	
+	uint16_t LineVolts;
+	
+	CurWeldLog.Mode = ((uint8_t)WeldSettings.Trigger << 4) | ((uint8_t)WeldSettings.Type & 0x0f);
+	CurWeldLog.Fault = wFaultNone;
+	CurWeldLog.Aux = 0;
+	CurWeldLog.P0 = 0;
+	CurWeldLog.P1 = 0;
+	LineVolts = WELD_GetLineVoltage();
+	CurWeldLog.Line = (LineVolts > 0xff) ? 0xff : (uint8_t)LineVolts;
+	CurWeldLog.Comp = 100;
+	CurWeldLog.Quality = wQualUnknown;
+	CurWeldLog.RDrop = 0;
+	LastFault = wFaultNone;
+	LastQuality = wQualUnknown;
+	
+	//Check the weld current shows up, and trace the resistance while it flows
+	ADC_StartMisfire(CurrentThreshold(_MISFIRE_MIN_A), (WeldSettings.Type == wTypeConstCurrent));
+	ADC_StartDynR(CurrentThreshold(_DR_MIN_A));
+	//Not in Capacitor Discharge - The bank voltage falls through every weld, it is not an expulsion
+	if(WeldSettings.Type != wTypeCapDischarge)
+		ADC_StartExpulsion(CurrentThreshold(_EXPEL_MIN_A));
+	else
+		ADC_ClearExpulsion();
+	
+	WeldLogPending = 1;
+}
+
+//Scale both pulse lengths of the current weld cycle (%), held to the min and max pulse length
+static uint16_t ScaleLength(uint16_t Length, uint16_t Pct);
+static uint16_t ScaleLength(uint16_t Length, uint16_t Pct){
+	
+	uint32_t Scaled;
+	
+	Scaled = ((uint32_t)Length * Pct) / 100;
+	if(Scaled < _MINWeldPulseLength_mS) return _MINWeldPulseLength_mS;
+	if(Scaled > _MAXWeldPulseLength_mS) return _MAXWeldPulseLength_mS;
+	return (uint16_t)Scaled;
+}
+static void ScalePulses(uint16_t Pct);
+static void ScalePulses(uint16_t Pct){
+	
+	CurWeldCycle.Pulse_0_Ticks = ScaleLength(CurWeldCycle.Pulse_0_Ticks, Pct);
+	CurWeldCycle.Pulse_1_Ticks = ScaleLength(CurWeldCycle.Pulse_1_Ticks, Pct);
+}
+
+//Scale the pulse lengths for the line voltage (Once per weld, before it is started)
+//Heat goes with the line voltage squared, so the pulses are scaled by (Nominal / Actual)^2
+static void LineCompensate(void);
+static void LineCompensate(void){
+	
+	uint16_t LineVolts;
+	uint32_t Comp;
+	
+	LineComp = 100;
+	
+	//Only the timed pulse modes - the others regulate the heat themselves
+	if( (WeldSettings.Type != wTypeSinglePulse) &&
+	    (WeldSettings.Type != wTypeDoublePulse) ) return;
+	
+	//No trusted reading - Weld as set
+	LineVolts = WELD_GetLineVoltage();
+	if(LineVolts < _LINE_MIN_V) return;
+	
+	Comp = ((uint32_t)_LINE_NOMINAL_V * _LINE_NOMINAL_V * 100) / ((uint32_t)LineVolts * LineVolts);
+	if(Comp < _LINE_COMP_MIN_PCT) Comp = _LINE_COMP_MIN_PCT;
+	if(Comp > _LINE_COMP_MAX_PCT) Comp = _LINE_COMP_MAX_PCT;
+	LineComp = (uint8_t)Comp;
+	
+	//Scale the pulses (Not the delay between them)
+	ScalePulses(Comp);
+}
+
+//Scale the pulse lengths for the contact resistance (Once per weld, before it is started)
+static void ContactCompensate(void);
+static void ContactCompensate(void){
+	
+	//Timed modes get longer pulses; energy mode gets a bigger target (See WELD_Service)
+	if( (WeldSettings.Type != wTypeSinglePulse) &&
+	    (WeldSettings.Type != wTypeDoublePulse) &&
+		(WeldSettings.Type != wTypeConstCurrent) ) return;
+	
+	ScalePulses(ContactHeat);
+}
+
+//Get the resistance of a dynamic resistance trace bin (uOhm, 0 = No current)
+static uint32_t DynRBin(uint8_t Bin);
+static uint32_t DynRBin(uint8_t Bin){
+	
+	adc_drbin_s_t Data;
+	
+	if(!ADC_GetDynRBin(Bin, &Data)) return 0;
+	
+	//Keep V * 1000 in 32 bits
+	while(Data.V > 0x3FFFFFUL){
+		Data.V >>= 1;
+		Data.I >>= 1;
+	}
+	if(!Data.I) return 0;
+	
+	//Raw V / Raw I, then to uOhm (The reference cancels out)
+	return ((Data.V * 1000) / Data.I) * (1000UL * _CD_VCAP_SCALE_NUM) / ((uint32_t)_CD_VCAP_SCALE_DEN * _ISENSE_A_PER_V);
+}
+
+//Classify the last weld from its dynamic resistance (Peak, drop from the peak, and the end value)
+static void WeldClassify(void);
+static void WeldClassify(void){
+	
+	uint8_t Bins, i;
+	uint32_t R, Last = 0, Peak = 0, Step, MaxStep = 0, Drop;
+	
+	ADC_StopDynR();
+	Bins = ADC_GetDynRBins();
+	if(Bins < _DR_MIN_BINS) return;
+	
+	for(i = 0; i < Bins; i++){
+		R = DynRBin(i);
+		if(!R) continue;
+		if(R > Peak) Peak = R;
+		//Biggest drop from one bin to the next (%)
+		if(Last > R){
+			Step = ((Last - R) * 100) / Last;
+			if(Step > MaxStep) MaxStep = Step;
+		}
+		Last = R;
+	}
+	if(!Peak) return;
+	
+	//Drop from the peak to the end (%)
+	Drop = ((Peak - Last) * 100) / Peak;
+	CurWeldLog.RDrop = (uint8_t)Drop;
+	
+	if(MaxStep >= _DR_EXPULSION_STEP_PCT)
+		CurWeldLog.Quality = wQualExpulsion;
+	else if(Drop < _DR_COLD_DROP_PCT)
+		CurWeldLog.Quality = wQualCold;
+	else
+		CurWeldLog.Quality = wQualGood;
+}
+
+//Finish the Weld Log entry for the last weld and save it
+static void WeldLogFinish(void);
+static void WeldLogFinish(void){
+	
+	uint32_t FireUS, Latency, Delivered;
+	
+	//No current?
+	ADC_StopMisfire();
+	if(ADC_IsMisfire()) CurWeldLog.Fault = wFaultMisfire;
+	
+	//How good was it? An expulsion cut short is always one
+	WeldClassify();
+	ADC_StopExpulsion();
+	if(ADC_IsExpelled()) CurWeldLog.Quality = wQualExpulsion;
+	
+	//Energy delivered (% of the target the weld ran to - Includes the contact heat)
+	if(WeldSettings.Type == wTypeEnergy){
+		ADC_StopEnergy();
+		Delivered = ADC_GetEnergy() / ((((WELD_JoulesToEnergy(WeldSettings.Energy) / 100) * ContactHeat) / 100) + 1);
+		CurWeldLog.Aux = (Delivered > 0xff) ? 0xff : (uint8_t)Delivered;
+		//Ran out of time before the target?
+		if( !ADC_IsEnergyReached() && (CurWeldLog.Fault == wFaultNone) ) CurWeldLog.Fault = wFaultEnergy;
+	}
+	
+	//Last half cycle current (A / 10)
+	if(WeldSettings.Type == wTypeConstCurrent){
+		Delivered = GetPhaseCurrent() / 10;
+		CurWeldLog.Aux = (Delivered > 0xff) ? 0xff : (uint8_t)Delivered;
+	}
+	
+	//Get the time the weld output was first turned on 
+	if(WeldSettings.Type == wTypeContinuous)
+		FireUS = ContStartUS;
+	else
+		FireUS = GetWeldFireMicros();
+	
+	//Trigger to fire time (uS, logged in 0.1mS)
+	Latency = FireUS - TriggerUS;
+	if((int32_t)Latency >= 0){
+		LastLatencyUS = Latency;
+		Latency /= 100;
+		if(Latency > 0xffff) Latency = 0xffff;
+	}else{
+		//Never fired (Fire time is from an earlier weld)
+		LastLatencyUS = 0xffffffff;
+		Latency = 0xffff;
+	}
+	CurWeldLog.Latency = (uint16_t)Latency;
+	
+	//Trace any fault
+	if(CurWeldLog.Fault != wFaultNone) TRACE_Event(TrcEvt_Fault, CurWeldLog.Fault);
+	
+	WLOG_Record(&CurWeldLog);
+	LastFault = CurWeldLog.Fault;
+	LastQuality = CurWeldLog.Quality;
+	WeldLogPending = 0;
 }
 
-//Private Control Functions 
 
 //Control Functions *********
 uint8_t WaitZeroX(void){
 	
 	uint32_t EntryTime;
+	uint16_t Wait;
+	
+	//Only a crossing after the call counts
+	ZeroX_Detected = 0;
+	
+	//Called with interrupts off (From the weld timer ISR)?
+	//The tick and zero cross ISRs can't run, so poll the zero cross flag instead.
+	//A flag already set is a crossing that has passed; a fresh one comes 
+	//within a half cycle, so don't hold interrupts off any longer than that
+	if(!(SREG & _BV(SREG_I))){
+		EIFR = _BV(INTF0);
+		for(Wait = 0; Wait < (_MAXZeroXWaitIntOff_US / _ZeroXPollIntOff_US); Wait++){
+			if(EIFR & _BV(INTF0)) return 1;
+			_delay_us(_ZeroXPollIntOff_US);
+		}
+		//No Zero X (Timed Out)
+		TRACE_Overrun(_TRACE_OVR_ZEROX);
+		ZeroXLost = 1;
+		return 0;
+	}
 	
 	EntryTime = GetSysTicks();
 	
@@ -172,46 +671,152 @@ uint8_t WaitZeroX(void){
 //Prepare welder for operation
 void WELD_Init(void){
 	//Enable interrupts
-	//Analog Comparator (Rising Edge Interrupt)
-	//ACSR |= (_BV(ACIS0)| _BV(ACIS1) | _BV(ACIE));
-	//INT0 = Zero Cross, INT1 = Foot switch, INT2 = TERM DET
-	//Int0 (Any Edge 0x01), Int1 (Low Level 0x00), INT2 (rising Edge 0x3)
-	EICRA |= (_BV(ISC00) | _BV(ISC21) | _BV(ISC20) );
-	//Enable INT0, 1, 2
-	EIMSK |= (_BV(INT0) | _BV(INT1) | _BV(INT2));
+#if defined( _CONTACT_ACIC )
+	//Analog Comparator = TERM DET: AIN0 (Sense) vs AIN1 (DAC), routed to Timer 1 input capture
+	DIDR1 = _BV(AIN1D) | _BV(AIN0D);
+	ACSR = _BV(ACIC);
+	TCCR1B |= _BV(ICNC1);
+#else
+	//INT2 = TERM DET (Any Edge 0x01) - Enabled by EnaContactDetect
+	EICRA |= _BV(ISC20);
+#endif
+	//INT0 = Zero Cross, INT1 = Foot switch
+	//Int0 (Any Edge 0x01), Int1 (Falling Edge 0x02)
+	EICRA |= _BV(ISC00) | _BV(ISC11);
+	EIFR = _BV(INTF1);
+	//Enable INT0, 1
+	EIMSK |= (_BV(INT0) | _BV(INT1));
 	//Set initial disabled state 
 	WeldEnabled = 0;
 	//Set Not triggered 
 	WeldTriggered = 0;
 }
+
+//Check the trigger is still held (Repeat) - Contact sensing needs the measurement relay closed
+static uint8_t TriggerHeld(void);
+static uint8_t TriggerHeld(void){
+	
+	switch(WeldSettings.Trigger){
+		case wTrigContactFS:
+			//Pedal down, and the contact as well
+			if(!_FootSWDown) return 0;
+		case wTrigContact:
+			return ( (MRelayService() == MRelay_Closed) && _CONTACT_MADE );
+		case wTrigForce:
+			return ForceAbove;
+		default:
+			return _FootSWDown;
+	}
+}
+
 //Weld servicer - runs weld cycles - call periodically to run weld system
 void WELD_Service(void){
 	
 	static uint32_t NextStepTime, EntryTime, NextWeld;
-	static uint8_t TriggerStarted, ResetStarted;
+	static uint8_t TriggerStarted, ResetStarted, ChargeWaitStarted;
+	static uint8_t LastTriggered = 0xff, LastCharged;
+	static uint8_t PedalArmed = 0;
+	static uint8_t RepeatStarted = 0;						//1 = Off time running, 2 = Run ended (Trigger let go)
+	static uint32_t RepeatTime;
+	uint8_t Triggered, Armed;
 			
 	EntryTime = GetSysTicks();
 	
+	//Sample the electrode force
+	WELD_ForceTick();
+	
+	//Trace trigger state changes
+	Triggered = WeldTriggered;
+	if(Triggered != LastTriggered){
+		TRACE_Event(TrcEvt_Trigger, Triggered);
+		LastTriggered = Triggered;
+	}
+	
+	//Show charge changes on the home screen
+	if( (WeldSettings.Type == wTypeCapDischarge) && (ChargeReady != LastCharged) ){
+		LastCharged = ChargeReady;
+		if(WeldEnabled) UI_ForceUpdate();
+	}
+	
+	//A pedal press only counts while the trigger is waiting for one
+	if( (WeldTriggered != 0) || (CurWeldCycle.Stage != WeldStage_Wait) || !WeldEnabled ) FootPressed = 0;
+	//The off time only runs between the welds of a repeat
+	if(WeldTriggered != 3) RepeatStarted = 0;
+	if( (WeldTriggered != 3) || !WeldEnabled ) MisfireRetry = 0;
+	if( (WeldTriggered == 0) || !WeldEnabled ) WeldPreArmed = 0;
+	//Stitch - Letting the pedal up ends the off time (A quick press starts a new one)
+	if( (WeldSettings.Trigger == wTrigStitch) && !_FootSWDown ){
+		RepeatStarted = 0;
+		WeldPreArmed = 0;
+	}
+	
 	//Trigger state 0, reset the trigger system
 	if(WeldTriggered == 0){
 		//Check if we can reset the trigger yet
 		if(CurWeldCycle.Stage == WeldStage_Wait){
 			//Check what trigger mode is being used and reset it
-			if (WeldSettings.Trigger == wTrigContact){
-				if(WeldEnabled) {
-					//Connect Terminal Measure Relay
-					_MRELAY_ON;
-					//Enable Terminal Measure Detect
+			if ( (WeldSettings.Trigger == wTrigContact) || (WeldSettings.Trigger == wTrigContactFS) ){
+				Armed = WeldEnabled;
+				//Contact + Foot switch: Only armed while the pedal is held down
+				if(WeldSettings.Trigger == wTrigContactFS){
+					if(!_FootSWDown) Armed = 0;
+					if(Armed && !PedalArmed) Beep(20);
+					PedalArmed = Armed;
+					if(!Armed) MRelayRequest(0);
+				}
+				//Connect Terminal Measure Relay (Normally already closed during the cooldown)
+				if(Armed) MRelayRequest(1);
+				//Enable Terminal Measure Detect once the relay has stopped bouncing
+				if( Armed && (MRelayService() == MRelay_Closed) ) {
 					_EnaTermDetect;
+					//Contact made and settled? Trigger, timed from when it was made
+					ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+						if( ContactMade && ((GetSysMicros() - ContactMakeUS) >= _CONTACT_DWELL_US) ){
+							//Edges are still recorded through the trigger delay
+							WeldTriggered = 1;
+							TriggerUS = ContactMakeUS;
+							TriggerTS = EntryTime - ((GetSysMicros() - TriggerUS) / (_MS_PER_SYSTICK * 1000UL));
+						}
+					}
+					//Probe swapped? Load its settings (Only while nothing is touching)
+					if(WeldTriggered == 0) PROBE_Service();
+				}
+				//Contact + Foot switch: Pedal down - Load the cycle now (Each pass, so it follows 
+				//the settings), the weld timer is started as soon as the contact is made
+				if( (WeldSettings.Trigger == wTrigContactFS) && Armed ){
+					LoadWeldCycle();
+					WeldPreArmed = 1;
 				}
 			}
 			
-			if (WeldSettings.Trigger == wTrigFootSwitch){
+			if (WeldSettings.Trigger == wTrigForce){
 				if(WeldEnabled) {
 					//Disconnect Terminal Measure Relay
-					_MRELAY_OFF;
-					//Enable Foot switch detection
-					_EnaFootSW;
+					MRelayRequest(0);
+					//Force up and steady? Trigger, timed from when it settled (Not while the serial
+					//port has the load cell clock - The force can not be current)
+					ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+						if(ForceStable && !_SER_TX_ON){
+							WeldTriggered = 1;
+							TriggerUS = ForceStableUS;
+							TriggerTS = EntryTime - ((GetSysMicros() - TriggerUS) / (_MS_PER_SYSTICK * 1000UL));
+						}
+					}
+				}
+			}
+			
+			if ( (WeldSettings.Trigger == wTrigFootSwitch) || (WeldSettings.Trigger == wTrigStitch) ){
+				if(WeldEnabled) {
+					//Disconnect Terminal Measure Relay
+					MRelayRequest(0);
+					//Pressed? Trigger, timed from the press edge
+					//(The press time is written before the flag and not again until a release)
+					if(FootPressed){
+						FootPressed = 0;
+						WeldTriggered = 1;
+						TriggerUS = FootPressUS;
+						TriggerTS = EntryTime - ((GetSysMicros() - TriggerUS) / (_MS_PER_SYSTICK * 1000UL));
+					}
 				}
 			}
 		}
@@ -221,27 +826,46 @@ void WELD_Service(void){
 	if(WeldTriggered == 1){
 		//What mode are we in?
 		switch (WeldSettings.Trigger){
-			//Contact detection Trigger
+			//Contact detection Trigger (Contact + Foot switch has no trigger delay - the pedal was the wait)
 			case wTrigContact:
+			case wTrigContactFS:
+				//Minimum latency - No delay or beep, check the contacts in this pass
+				if(!TriggerStarted && (_MinLatency || (WeldSettings.Trigger == wTrigContactFS))){
+					NextStepTime = TriggerTS;
+					TriggerStarted = 1;
+				}
 				if(!TriggerStarted){
 					UI_ForceUpdate();
-					//Set next Trigger step time
-					NextStepTime = EntryTime + (WeldSettings.Trig_Delay / _MS_PER_SYSTICK);
+					//Set next Trigger step time (From the contact instant)
+					NextStepTime = TriggerTS + (WeldSettings.Trig_Delay / _MS_PER_SYSTICK);
 					//Prepare next trigger state
 					TriggerStarted = 1;
 					Beep(100);
 				}else{
-					//Check if Terminals disconnected
-					if((_CSINPINS & _BV(_CSINPIN)) == 0){
+					//Check if Terminals disconnected (Or the pedal let go)
+					if( !_CONTACT_MADE || ((WeldSettings.Trigger == wTrigContactFS) && !_FootSWDown) ){
 						//Terminals Disconnected
 						//Reset Trigger
 						WeldTriggered = TriggerStarted = 0;
 						Beep(100);
 						UI_ForceUpdate();
 					}else{
-						if(EntryTime > NextStepTime){
-							//Disconnect Terminal Measure relay
-							_MRELAY_OFF;
+						if(EntryTime >= NextStepTime){
+							//Measure the contacts while the relay is still on
+							if(ContactCheck() < 0){
+								//Out of range - Refuse the weld
+								LastFault = wFaultContactR;
+								TRACE_Event(TrcEvt_Fault, wFaultContactR);
+								CurWeldCycle.Stage = WeldStage_End;
+								SetActiveWeldState(WeldStage_End);
+								WeldTriggered = 3;
+								TriggerStarted = 0;
+								Beep(500);
+								UI_ForceUpdate();
+								break;
+							}
+							//Disconnect Terminal Measure relay (The weld waits for it to open)
+							MRelayRequest(0);
 							//Go to next stage of triggering
 							WeldTriggered = 2;
 							//Reset trigger state
@@ -252,15 +876,26 @@ void WELD_Service(void){
 					}
 				}
 				break;
-			//Foot-Switch Trigger
+			//Foot-Switch Trigger (A stitch starts like a single weld)
 			case wTrigFootSwitch:
+			case wTrigStitch:
+				//Minimum latency - No delay or beep, go to the weld in this pass
+				if(!TriggerStarted && _MinLatency && (WeldSettings.Type != wTypeContinuous)){
+					ContactR = 0;
+					ContactHeat = 100;
+					NextStepTime = TriggerTS;
+					TriggerStarted = 1;
+				}
 				if(!TriggerStarted){
 					UI_ForceUpdate();
-					//Set Next Trigger step time
+					//No contact measurement with the foot switch
+					ContactR = 0;
+					ContactHeat = 100;
+					//Set Next Trigger step time (From the press)
 					if(WeldSettings.Type == wTypeContinuous)
-						NextStepTime = EntryTime + (_UI_MIN_FOOTSW_MS / _MS_PER_SYSTICK);
+						NextStepTime = TriggerTS + (_UI_MIN_FOOTSW_MS / _MS_PER_SYSTICK);
 					else
-						NextStepTime = EntryTime + (WeldSettings.Trig_Delay / _MS_PER_SYSTICK);
+						NextStepTime = TriggerTS + (WeldSettings.Trig_Delay / _MS_PER_SYSTICK);
 					//Prepare Next trigger state
 					TriggerStarted = 1;
 					//Beep to indicate detection of Foot Switch
@@ -275,9 +910,9 @@ void WELD_Service(void){
 						UI_ForceUpdate();
 					}else{
 						//Has time expired yet?
-						if(EntryTime > NextStepTime){
+						if(EntryTime >= NextStepTime){
 							//Disconnect Measure relay
-							_MRELAY_OFF;
+							MRelayRequest(0);
 							//Go to next trigger stage
 							WeldTriggered = 2;
 							//Reset Trigger state
@@ -290,14 +925,27 @@ void WELD_Service(void){
 					}
 				}
 				break;
+			//Force Trigger - Holding the force steady was the delay
+			case wTrigForce:
+				UI_ForceUpdate();
+				//No contact measurement with the force trigger
+				ContactR = 0;
+				ContactHeat = 100;
+				//Go to next trigger stage (Once the measurement relay is open)
+				MRelayRequest(0);
+				WeldTriggered = 2;
+				TriggerStarted = 0;
+				//Beep to signify Weld Start
+				Beep(50);
+				break;
 			//Any other State
 			default:
 			TriggerStarted = WeldEnabled = 0;
 		}
 	}
 	
-	//check for stage 2 triggering (Start the weld)
-	if(WeldTriggered == 2){
+	//check for stage 2 triggering (Start the weld, once the measurement relay is open)
+	if( (WeldTriggered == 2) && (MRelayService() == MRelay_Open) ){
 		//Check what weld mode we are in
 		switch (WeldSettings.Type){
 			case wTypeContinuous:
@@ -318,7 +966,14 @@ void WELD_Service(void){
 								//Turn On Weld
 								_GPIOWeld_ON;
 								CurWeldCycle.Stage = WeldStage_Run;
+								//Start the log entry
+								ContStartUS = GetSysMicros();
+								WeldLogStart();
 							}
+						}else if(ADC_IsMisfire() || ADC_IsExpelled()){
+							//No current or expulsion - Output was cut, stop until the switch is pressed again
+							CurWeldCycle.Stage = WeldStage_End;
+							WeldTriggered = 3;
 						}
 					}else{
 						//Weld Was disabled for some reason...
@@ -332,6 +987,11 @@ void WELD_Service(void){
 					WaitZeroX();
 					//Turn Off Weld
 					_GPIOWeld_OFF;
+					//Save the on time in weld ticks
+					if(WeldLogPending){
+						uint32_t OnTicks = (GetSysMicros() - ContStartUS) / (_MS_PER_WELDTICK * 1000UL);
+						CurWeldLog.P0 = (OnTicks > 0xff) ? 0xff : (uint8_t)OnTicks;
+					}
 					//Set stage
 					CurWeldCycle.Stage = WeldStage_End;
 					//Reset trigger
@@ -342,23 +1002,53 @@ void WELD_Service(void){
 				SetActiveWeldState(CurWeldCycle.Stage);
 				break;
 			
+			case wTypeCapDischarge:
+				//Only fire from a charged bank
+				if(!ChargeReady){
+					//Start waiting
+					if(!ChargeWaitStarted){
+						ChargeWaitStarted = 1;
+						NextStepTime = EntryTime + (_CD_CHARGE_TIMEOUT_mS / _MS_PER_SYSTICK);
+					}
+					//Give up if it takes too long
+					if(EntryTime > NextStepTime){
+						ChargeWaitStarted = 0;
+						Beep(500);
+						//Reset Trigger
+						WeldTriggered = 3;
+					}
+					break;
+				}
+				ChargeWaitStarted = 0;
+				//Charged - Fire a single pulse
 			case wTypeSinglePulse:
 			case wTypeDoublePulse:
-				//Load Weld Parameters
-				CurWeldCycle.Pulse_0_Ticks = WeldSettings.P0_Length;
-				CurWeldCycle.Pulse_1_Ticks = WeldSettings.P1_Length;
-				CurWeldCycle.Delay_0_Ticks = WeldSettings.IP_Delay;
-				if(WeldSettings.Type == wTypeSinglePulse) CurWeldCycle.Type = WeldType_Single;
-				if(WeldSettings.Type == wTypeDoublePulse) CurWeldCycle.Type = WeldType_Double;
+			case wTypeEnergy:
+			case wTypeConstCurrent:
+				//Load Weld Parameters (A stitch loads them during the off time, Contact + Foot switch while armed)
+				if(!WeldPreArmed) LoadWeldCycle();
 				CurWeldCycle.Stage = WeldStage_Wait;
 				//Prepare to start Weld
 				if(WeldEnabled){
-					//Disconnect Measurement Relay
-					_MRELAY_OFF;
-					//Start the Weld
+					//Start the log entry
+					WeldLogStart();
+					//Compensate for the line voltage
+					LineCompensate();
+					CurWeldLog.Comp = LineComp;
+					//Adapt the heat to the contact resistance
+					ContactCompensate();
+					CurWeldLog.P0 = CurWeldCycle.Pulse_0_Ticks / _MS_PER_WELDTICK;
+					if(WeldSettings.Type == wTypeDoublePulse) 
+						CurWeldLog.P1 = CurWeldCycle.Pulse_1_Ticks / _MS_PER_WELDTICK;
+					//Arm the energy integrator (P0 is the max time)
+					if(WeldSettings.Type == wTypeEnergy)
+						ADC_StartEnergy((WELD_JoulesToEnergy(WeldSettings.Energy) / 100) * ContactHeat);
+					//Start the Weld (Now, not on the next weld tick, for minimum latency)
 					StartWeldCycle(&CurWeldCycle);
+					if(_MinLatency || WeldPreArmed) WeldTimerTickNow();
 					UI_ResetActivity();
 				}
+				WeldPreArmed = 0;
 				//Reset Trigger
 				WeldTriggered = 3;
 				break;
@@ -372,7 +1062,7 @@ void WELD_Service(void){
 		
 		//Set Next Entry Time
 		if(WeldTriggered == 3){
-			NextWeld = EntryTime + (_INTERWELD_Delay_mS / _MS_PER_SYSTICK);
+			NextWeld = EntryTime + InterWeldDelay();
 		}
 		
 	}	
@@ -386,39 +1076,122 @@ void WELD_Service(void){
 			//Set the Trigger stage to 3
 			WeldTriggered = 3;
 			//Set Next Weld Time
-			NextWeld = EntryTime + (_INTERWELD_Delay_mS / _MS_PER_SYSTICK);
-			//Enable Foot switch detection
-			_EnaFootSW;
+			NextWeld = EntryTime + InterWeldDelay();
 		}
 	}
 	
 	//Check for weld stage 3 - Wait for next weld 
 	if(WeldTriggered == 3){
 		if(GetActiveWeldState() == WeldStage_End){
+			//Weld finished - Log it
+			if(WeldLogPending){
+				WeldLogFinish();
+				if(LastFault == wFaultMisfire){
+					//Misfire - Retry once the inter-weld delay is up (Not manual welds)
+					if( (WeldSettings.Type != wTypeContinuous) && (MisfireRetries < _MISFIRE_RETRIES) && WeldEnabled ){
+						MisfireRetries++;
+						MisfireRetry = 1;
+						NextWeld = EntryTime + InterWeldDelay();
+						return;
+					}
+					//Out of retries - Tell the operator
+					Beep(500);
+				}
+				MisfireRetries = 0;
+				//Show the verdict
+				UI_ForceUpdate();
+			}
+			//Misfire retry waiting for the inter-weld delay
+			if(MisfireRetry){
+				if(EntryTime <= NextWeld) return;
+				MisfireRetry = 0;
+				WeldTriggered = 2;
+				return;
+			}
+			//Stitch - Weld again while the pedal stays down, once the off time is up
+			if( (WeldSettings.Trigger == wTrigStitch) && (LastFault == wFaultNone) && _FootSWDown ){
+				if(!RepeatStarted){
+					RepeatStarted = 1;
+					RepeatTime = EntryTime + StitchOffTime();
+					//Pre-arm - Load the next cycle now, it fires as soon as the off time is up
+					LoadWeldCycle();
+					WeldPreArmed = 1;
+				}
+				if(EntryTime >= RepeatTime){
+					RepeatStarted = 0;
+					//Timed from the end of the off time
+					TriggerUS = GetSysMicros();
+					TriggerTS = EntryTime;
+					CurWeldCycle.Stage = WeldStage_Wait;
+					SetActiveWeldState(WeldStage_Wait);
+					WeldTriggered = 2;
+				}
+				return;
+			}
+			//Repeat (Off time set) - Weld again hands-free once the off time is up, while the trigger 
+			//is still held, until the weld is disabled or a weld faults (Never faster than the inter-weld delay)
+			if( WeldSettings.Off_Time && (WeldSettings.Type != wTypeContinuous) && 
+			    (WeldSettings.Trigger != wTrigStitch) && (LastFault == wFaultNone) && (RepeatStarted != 2) ){
+				if(!RepeatStarted){
+					RepeatStarted = 1;
+					RepeatTime = WeldSettings.Off_Time / _MS_PER_SYSTICK;
+					if(RepeatTime < InterWeldDelay()) RepeatTime = InterWeldDelay();
+					RepeatTime += EntryTime;
+				}
+				//Contact sensing needs the measurement relay (The weld waits for it to open again)
+				if( (WeldSettings.Trigger == wTrigContact) || (WeldSettings.Trigger == wTrigContactFS) ) 
+					MRelayRequest(1);
+				if(EntryTime < RepeatTime) return;
+				//Let go? End of the run - Reset as after a single weld
+				if(!TriggerHeld()){
+					RepeatStarted = 2;
+				}else{
+					RepeatStarted = 0;
+					//Still held - The latency is timed from the end of the off time
+					TriggerUS = GetSysMicros();
+					TriggerTS = EntryTime;
+					//The contacts are not measured again
+					ContactR = 0;
+					ContactHeat = 100;
+					CurWeldCycle.Stage = WeldStage_Wait;
+					SetActiveWeldState(WeldStage_Wait);
+					WeldTriggered = 2;
+					return;
+				}
+			}
 			//Check to see if terminals or foot-switch have been released
 			//Terminals 
-			if(WeldSettings.Trigger == wTrigContact){
-				//Reconnect Measurement relay
-				_MRELAY_ON;
-				if((_CSINPINS & _BV(_CSINPIN)) == 0 ) 
+			if( (WeldSettings.Trigger == wTrigContact) || (WeldSettings.Trigger == wTrigContactFS) ){
+				//Reconnect Measurement relay - it settles during the cooldown
+				MRelayRequest(1);
+				if( (MRelayService() == MRelay_Closed) && !_CONTACT_MADE ) 
 					ResetStarted = 1;
 				else
 					ResetStarted = 0;
 			}
 			//Foot switch
-			if(WeldSettings.Trigger == wTrigFootSwitch){
+			if( (WeldSettings.Trigger == wTrigFootSwitch) || (WeldSettings.Trigger == wTrigStitch) ){
 				if((_FSWINPINS & _BV(_FSWINPIN)) != 0 )
 					ResetStarted = 1;
 				else 
 					ResetStarted = 0;
 			}
+			//Electrode force
+			if(WeldSettings.Trigger == wTrigForce){
+				if(!ForceAbove)
+					ResetStarted = 1;
+				else 
+					ResetStarted = 0;
+			}
 			
 			if(!ResetStarted){
 				//Set Next Weld Time
-				NextWeld = EntryTime + (_INTERWELD_Delay_mS / _MS_PER_SYSTICK);
+				NextWeld = EntryTime + InterWeldDelay();
 			}
 			
-			if(EntryTime > NextWeld){
+			//Capacitor discharge also waits for the charge
+			if( (EntryTime > NextWeld) && 
+			    ((WeldSettings.Type != wTypeCapDischarge) || ChargeReady) ){
 				WeldTriggered = 0;
 				CurWeldCycle.Stage = WeldStage_Wait;
 				SetActiveWeldState(WeldStage_Wait);
@@ -431,8 +1204,14 @@ void WELD_Service(void){
 	if( ZeroXLost ){
 		//Zero Cross has not been detected
 		//Breaker may be Open or Something is damaged
+		//Log the fault if it happened during a weld
+		if(WeldLogPending) CurWeldLog.Fault = wFaultZeroX;
 		//Disable Weld
 		DisableWeld();
+		//Trace it
+		TRACE_Event(TrcEvt_ZeroXLost, 0);
+		//Power may be going down - get any unsaved settings into EEPROM
+		EEQ_Flush();
 		
 		Beep(100);
 		
@@ -451,6 +1230,8 @@ void WELD_Service(void){
 			if(!ZeroXLost) break;
 		}
 		
+		TRACE_Event(TrcEvt_ZeroXFound, 0);
+		
 		//Reset the UI
 		UI_ResetActivity();
 					
@@ -466,13 +1247,20 @@ void WELD_Service(void){
 void DisableWeld(void){
 	//Check if we still need to disable Weld
 	if(WeldEnabled){
+		//Log the weld if one was started
+		if(WeldLogPending){
+			//Was it cut short?
+			if( (GetActiveWeldState() != WeldStage_End) && 
+			    (CurWeldLog.Fault == wFaultNone) ) CurWeldLog.Fault = wFaultHalted;
+			WeldLogFinish();
+		}
 		ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
 			//Stop any in progress Weld 
 			EmergencyHaltWeld();
 			//Disable any more welds 
 			WeldEnabled = 0;
 			//Disconnect Measurement relay
-			_MRELAY_OFF;
+			MRelayRequest(0);
 		}
 		//Update home screen
 		//UI_ForceUpdate();
@@ -493,14 +1281,48 @@ int EnableWeld(void){
 	if( (WeldSettings.IP_Delay < _MINWeldPulseDelay_mS) ||
 	    (WeldSettings.IP_Delay > _MAXWeldPulseDelay_mS) )		return (-3);
 		
-	//Trig Delay
-	if( (WeldSettings.Trig_Delay < _MINWeldPulseDelay_mS) ||
+	//Trig Delay (0 = Minimum latency)
+	if( (WeldSettings.Trig_Delay && (WeldSettings.Trig_Delay < _MINWeldPulseDelay_mS)) ||
 	    (WeldSettings.Trig_Delay > _MAXWeldPulseDelay_mS) )		return (-4);
 	
 	//Weld Type
 	if( (WeldSettings.Type != wTypeContinuous)  &&
 	    (WeldSettings.Type != wTypeSinglePulse) &&
-		(WeldSettings.Type != wTypeDoublePulse) )		return (-5);
+		(WeldSettings.Type != wTypeDoublePulse) &&
+		(WeldSettings.Type != wTypeCapDischarge) &&
+		(WeldSettings.Type != wTypeEnergy) &&
+		(WeldSettings.Type != wTypeConstCurrent) )		return (-5);
+#if defined( _FORCE_SOLENOID_FITTED )
+	//No charger fitted
+	if(WeldSettings.Type == wTypeCapDischarge)			return (-5);
+#endif
+	
+	//Capacitor Voltage
+	if( (WeldSettings.Type == wTypeCapDischarge) &&
+	    ((WeldSettings.Voltage < _MINWeldVoltage_mV) ||
+		 (WeldSettings.Voltage > _MAXWeldVoltage_mV)) )	return (-6);
+	
+	//Energy Target
+	if( (WeldSettings.Type == wTypeEnergy) &&
+	    ((WeldSettings.Energy < _MINWeldEnergy_J) ||
+		 (WeldSettings.Energy > _MAXWeldEnergy_J)) )	return (-7);
+	
+	//Current Target
+	if( (WeldSettings.Type == wTypeConstCurrent) &&
+	    ((WeldSettings.Current < _MINWeldCurrent_A) ||
+		 (WeldSettings.Current > _MAXWeldCurrent_A)) )	return (-8);
+	
+	//Force Setpoint
+	if( (WeldSettings.Trigger == wTrigForce) &&
+	    ((WeldSettings.Force < _MINWeldForce_N) ||
+		 (WeldSettings.Force > _MAXWeldForce_N)) )		return (-9);
+	
+	//Squeeze and Hold
+	if( (WeldSettings.Squeeze_Time > _MAXWeldSqueeze_mS) ||
+	    (WeldSettings.Hold_Time > _MAXWeldHold_mS) )		return (-10);
+	
+	//Off Time (0 = No repeat)
+	if(WeldSettings.Off_Time > _MAXWeldOff_mS)				return (-11);
 	
 	//Enable Weld Cycles to be started 
 	if(!WeldEnabled){
@@ -513,6 +1335,12 @@ int EnableWeld(void){
 			_StartWeldTimer;
 		}
 		
+		//First time ready since boot? 
+		if(!BootReadyTime){
+			BootReadyTime = GetSysMicros();
+			TRACE_Event(TrcEvt_Ready, (BootReadyTime < 255000UL) ? (uint8_t)(BootReadyTime / 1000) : 255);
+		}
+		
 		UI_ForceUpdate();
 	}
 	
@@ -528,6 +1356,315 @@ uint8_t IsWeldEnabled(void){
 	return WeldEnabled;
 }
 
+//Get the boot to ready time in uS (0 = Not ready yet)
+uint32_t WELD_GetBootReadyTime(void){
+	return BootReadyTime;
+}
+
+//Debounce the foot switch (Called from the system tick ISR)
+void WELD_FootSwitchTick(void){
+	
+	uint8_t Down = !(_FSWINPINS & _BV(_FSWINPIN));
+	
+	switch(FootState){
+		//Press edge seen - still down after the debounce time? Hand it to the weld service
+		case FootSW_Press:
+			if(++FootDebounce < (_FOOTSW_DEBOUNCE_MS / _MS_PER_SYSTICK)) break;
+			if(Down) FootPressed = 1;
+			FootDebounce = 0;
+			FootState = FootSW_Held;
+			break;
+		//Wait for a steady release, then listen for the next press
+		case FootSW_Held:
+			if(Down){
+				FootDebounce = 0;
+			}else if(++FootDebounce >= (_FOOTSW_DEBOUNCE_MS / _MS_PER_SYSTICK)){
+				EIFR = _BV(INTF1);
+				_EnaFootSW;
+				FootState = FootSW_Armed;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+//Sample the load cell and watch for a steady force (Called from the weld service)
+void WELD_ForceTick(void){
+	
+	int32_t Raw, Val;
+	uint32_t Now;
+	
+	//Only with the force trigger, and only when there is a new sample
+	if(WeldSettings.Trigger != wTrigForce){
+		ForceAbove = ForceStable = 0;
+		ForceSampleTS = GetSysTicks();
+		return;
+	}
+	if(!LC_Read(&Raw)){
+		//No samples (Unplugged, or the serial port has the clock) - Forget the force, and re-zero when they are back
+		if((GetSysTicks() - ForceSampleTS) > (_FORCE_STALE_MS / _MS_PER_SYSTICK)){
+			ForceAbove = ForceStable = 0;
+			ForceZeroed = 0;
+		}
+		return;
+	}
+	ForceSampleTS = GetSysTicks();
+	
+	//First sample is the zero (No force on the electrodes at power up)
+	if(!ForceZeroed){
+		ForceZero = Raw;
+		ForceZeroed = 1;
+	}
+	Val = (Raw - ForceZero) / _FORCE_COUNTS_PER_N;
+	Force = (Val > 0x7fff) ? 0x7fff : ((Val < -0x7fff) ? -0x7fff : (int16_t)Val);
+	
+	//Unloaded - let the zero follow the load cell drift
+	if(Force < (int16_t)((WeldSettings.Force * _FORCE_ZERO_PCT) / 100)) 
+		ForceZero += (Raw - ForceZero) >> _FORCE_ZERO_SHIFT;
+	
+	//Below the setpoint - Not pressing (yet)
+	if(Force < (int16_t)WeldSettings.Force){
+		ForceAbove = ForceStable = 0;
+		return;
+	}
+	
+	Now = GetSysMicros();
+	
+	//Just went over, or still moving? Start timing from here
+	if( !ForceAbove || (abs(Force - ForceRef) > (int16_t)((WeldSettings.Force * _FORCE_BAND_PCT) / 100)) ){
+		ForceAbove = 1;
+		ForceRef = Force;
+		ForceSinceUS = Now;
+		return;
+	}
+	
+	//Held steady long enough
+	if( !ForceStable && ((Now - ForceSinceUS) >= (_FORCE_STABLE_MS * 1000UL)) ){
+		ForceStable = 1;
+		ForceStableUS = Now;
+	}
+}
+
+//Get the electrode force (N)
+int16_t WELD_GetForce(void){
+	
+	int16_t TempVal;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = Force;
+	}
+	return TempVal;
+}
+
+//Regulate the capacitor bank charge (Called from the system tick ISR)
+void WELD_ChargeTick(void){
+	
+#if defined( _FORCE_SOLENOID_FITTED )
+	//No charger fitted
+	ChargeReady = 0;
+#else
+	uint16_t VCap;
+	
+	//Only in Capacitor Discharge mode, and never while discharging
+	if( (WeldSettings.Type != wTypeCapDischarge) ||
+	    (_WELDOUTPINS & _BV(_WELDOUTPIN)) ){
+		_CHARGE_OFF;
+		ChargeReady = 0;
+		return;
+	}
+	
+	VCap = WELD_GetCapVoltage();
+	
+	//Over voltage - Stop, and not safe to fire
+	if(VCap > (WeldSettings.Voltage + _CD_OVERVOLT_mV)){
+		_CHARGE_OFF;
+		ChargeReady = 0;
+		return;
+	}
+	
+	//Hysteresis control - Ready once the set voltage is reached
+	if(VCap >= WeldSettings.Voltage){
+		_CHARGE_OFF;
+		ChargeReady = 1;
+	}else{
+		if(VCap < (WeldSettings.Voltage - _CD_CHARGE_HYST_mV)) _CHARGE_ON;
+		if(VCap < (WeldSettings.Voltage - _CD_READY_BAND_mV)) ChargeReady = 0;
+	}
+#endif
+}
+
+//Get the capacitor bank voltage in mV
+uint16_t WELD_GetCapVoltage(void){
+	
+	return (uint16_t)(((uint32_t)ADC_GetMillivolts(_ADC_CH_VCAP) * _CD_VCAP_SCALE_NUM) / _CD_VCAP_SCALE_DEN);
+}
+
+//Get the charge state: 1 = Charged to the set voltage and ready to fire
+uint8_t WELD_IsCharged(void){
+	return ChargeReady;
+}
+
+//Convert Joules to energy integrator units (See ADC_StartEnergy())
+uint32_t WELD_JoulesToEnergy(uint16_t Joules){
+	
+	uint32_t Scale;
+	
+	//One raw V*I product is (AREF / 1024)^2 * VCAP scale * ISENSE scale (W)
+	Scale = (uint32_t)ADC_GetAREF() * ADC_GetAREF();
+	Scale >>= 10;
+	Scale *= _ISENSE_A_PER_V;
+	Scale >>= 10;
+	Scale = (Scale * _CD_VCAP_SCALE_NUM) / _CD_VCAP_SCALE_DEN;
+	//nJ per integrator count ( * scan time * 2^shift )
+	Scale = (Scale * _ADC_SCAN_TIME_US_X10 * (1 << _ADC_ENERGY_SHIFT)) / 10000;
+	if(!Scale) Scale = 1;
+	
+	return (uint32_t)Joules * (1000000000UL / Scale);
+}
+
+//Get the fault code of the last weld (See weldfault_e_t)
+uint8_t WELD_GetLastFault(void){
+	return LastFault;
+}
+
+//Close (1) or open (0) the measurement relay; the change is timed by WELD_Service
+void WELD_SetMRelay(uint8_t On){
+	MRelayRequest(On);
+}
+
+//Get the measurement relay state (See mrelay_e_t)
+uint8_t WELD_GetMRelay(void){
+	return MRelayService();
+}
+
+//Get the trigger to fire latency of the last weld (uS, 0xFFFFFFFF = Did not fire)
+uint32_t WELD_GetLastLatency(void){
+	return LastLatencyUS;
+}
+
+//Get the number of contact make/break edges seen (Wraps)
+uint16_t WELD_GetContactEdges(void){
+	
+	uint16_t TempVal;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = ContactEdges;
+	}
+	return TempVal;
+}
+
+//Get the bounces in the last touch, and the longest break between them (uS)
+uint8_t WELD_GetChatter(uint32_t* MaxGapUS){
+	
+	uint8_t TempVal;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		TempVal = ChatterBounces;
+		*MaxGapUS = ChatterMaxGap;
+	}
+	return TempVal;
+}
+
+//Read back a recorded contact edge; Age 0 = Newest.  Returns 1 if valid, 0 if not
+uint8_t WELD_GetChatterEdge(uint8_t Age, chatter_s_t* Edge){
+	
+	if(Age >= _CHATTER_LEN) return 0;
+	
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		*Edge = Chatter[(ChatterIndex - 1 - Age) & (_CHATTER_LEN - 1)];
+	}
+	return (Edge->US != 0);
+}
+
+//Find the electrode voltage as a threshold DAC code (Measurement relay must be on)
+//The threshold DAC is stepped as a successive approximation against the 
+//contact sense comparator; contact shows as made while the electrode 
+//voltage is below the DAC.  The trigger threshold and the contact capture 
+//are put back after; a real edge during the sweep is dated at its end.
+uint8_t WELD_SenseSAR(void){
+	
+	uint8_t Bit, Code = 0, TermDetect;
+	
+	//No contact edges from the sweep
+	TermDetect = _TermDetectOn;
+	_DisTermDetect;
+	
+	for(Bit = 0x80; Bit; Bit >>= 1){
+		MCP48_SetValue((uint16_t)(Code | Bit), _MCP48_GAIN_2);
+		_delay_us(_CR_SETTLE_US);
+		//Electrode voltage still above the DAC - Keep the bit
+		if(!_CONTACT_MADE) Code |= Bit;
+	}
+	
+	//Put the trigger threshold back
+	MCP48_SetValue((uint16_t)ContactTrigLevel, _MCP48_GAIN_2);
+	_delay_us(_CR_SETTLE_US);
+	
+	//Drop the sweep's edges and carry on capturing from the state before it
+	if(TermDetect){
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+			//Made or broken during the sweep?
+			if(_CONTACT_MADE && !ContactMade){
+				ContactMade = 1;
+				ContactMakeUS = GetSysMicros();
+				_TermNextEdge(1);
+			}else if(!_CONTACT_MADE && ContactMade){
+				ContactMade = 0;
+				ContactBreakUS = GetSysMicros();
+				_TermNextEdge(0);
+			}
+			_ClrTermEdge;
+			_ArmTermDetect;
+		}
+	}
+	
+	return Code;
+}
+
+//Check the contact capture is idle - Measurement relay closed, capture armed, 
+//no contact and no edge waiting.  Returns 1 if idle
+uint8_t WELD_IsContactIdle(void){
+	
+	uint8_t Idle;
+	
+	if(MRelayState != MRelay_Closed) return 0;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE){
+		Idle = _TermDetectOn && !ContactMade && !_CONTACT_MADE && !_TermEdgePending;
+	}
+	return Idle;
+}
+
+//Get the quality verdict of the last weld (See weldquality_e_t)
+uint8_t WELD_GetLastQuality(void){
+	return LastQuality;
+}
+
+//Get the contact resistance measured for the last weld (mOhm, 0xffff = Open)
+uint16_t WELD_GetContactR(void){
+	return ContactR;
+}
+
+//Get the heat scale used for the contact resistance (%)
+uint8_t WELD_GetContactHeat(void){
+	return ContactHeat;
+}
+
+//Get the RMS line voltage (V)
+uint16_t WELD_GetLineVoltage(void){
+	
+	uint32_t Rms;
+	
+	//Pin mV, then line V
+	Rms = ((uint32_t)ADC_GetLineRMS() * ADC_GetAREF()) >> 10;
+	return (uint16_t)((Rms * _VLINE_V_PER_V) / 1000);
+}
+
+//Get the line compensation applied to the last weld (% of the set pulse length)
+uint8_t WELD_GetLineComp(void){
+	return LineComp;
+}
+
 //Get Current Weld Settings
 weldctrl_s_t* GetWeldSettings(void){
 	return &WeldSettings;
@@ -39,6 +39,9 @@
 
 //Weld defaults
 #define _WeldDef_Voltage				3500
+#define _WeldDef_Energy					100
+#define _WeldDef_Current				300
+#define _WeldDef_Force					50
 #define _WeldDef_P0						250
 #define _WeldDef_P1						300
 #define _WeldDef_IP						100
@@ -46,23 +49,145 @@
 #define _WeldDef_Trig					0
 #define _WeldDef_Type					0
 #define _WeldDef_TrigThrs				200
+#define _WeldDef_Squeeze				0
+#define _WeldDef_Hold					0
+#define _WeldDef_Off					0
 
 //Min/Max Weld parameters
 #define _MINWeldPulseDelay_mS			50
+#define _MINTrigDelay_mS				0			//Trigger delay of 0 = Minimum latency mode
 #define _MAXWeldPulseDelay_mS			1000
 #define _MINWeldPulseLength_mS			50
 #define _MAXWeldPulseLength_mS			10000
+#define _MINWeldVoltage_mV				1000
+#define _MAXWeldVoltage_mV				4900
+#define _StepWeldVoltage_mV				50
+#define _MINWeldEnergy_J				5
+#define _MAXWeldEnergy_J				2000
+#define _StepWeldEnergy_J				5
+#define _MINWeldCurrent_A				50
+#define _MAXWeldCurrent_A				1000
+#define _StepWeldCurrent_A				10
+#define _MINWeldForce_N					5
+#define _MAXWeldForce_N					500
+#define _StepWeldForce_N				5
+#define _MAXWeldSqueeze_mS				2000		//Squeeze of 0 = Force solenoid not used
+#define _MAXWeldHold_mS					2000
+#define _MAXWeldOff_mS					10000		//Off time of 0 = No repeat
 
 #define _INTERWELD_Delay_mS				1000
 
+//Capacitor Discharge settings
+#define _CD_VCAP_SCALE_NUM				1			//Bank voltage = VCAP pin voltage * NUM / DEN 
+#define _CD_VCAP_SCALE_DEN				1
+#define _CD_CHARGE_HYST_mV				50			//Charger turns back on this far below the set voltage
+#define _CD_READY_BAND_mV				100			//Not ready if this far below the set voltage
+#define _CD_OVERVOLT_mV					200			//Not ready if this far above the set voltage
+#define _CD_CHARGE_TIMEOUT_mS			10000		//Longest wait for a charge once triggered
+#define _CD_INTERWELD_Delay_mS			100			//Minimum time between welds (Charge permitting)
+
+//Energy terminated weld settings
+#define _ISENSE_A_PER_V					200			//Weld current per volt at the ISENSE pin
+
+//Line voltage compensation settings
+#define _VLINE_V_PER_V					100			//Line voltage per volt at the VLINE pin
+#define _LINE_NOMINAL_V					120			//Line voltage the pulse lengths are set for
+#define _LINE_MIN_V						60			//Below this the reading is not trusted (No compensation)
+#define _LINE_COMP_MIN_PCT				70			//Compensation limits (% of the set pulse length)
+#define _LINE_COMP_MAX_PCT				150
+
+//Misfire detection settings
+#define _MISFIRE_MIN_A					20			//Current that counts as 'Fired'
+#define _MISFIRE_RETRIES				1			//Automatic retries after a misfire (0 = None)
+
+//Contact detection settings
+#define _CONTACT_DWELL_US				5000		//Contact must stay made this long to trigger (Chatter filter)
+#define _CHATTER_LEN					16			//Contact edges kept for diagnostics (Power of 2)
+#define _CHATTER_NEW_TOUCH_US			200000UL	//A break longer than this starts a new touch (Not a bounce)
+
+//Measurement relay settings
+#define _MRELAY_SETTLE_MS				15			//Relay contacts closed and done bouncing this long after the coil is on
+#define _MRELAY_RELEASE_MS				10			//Relay contacts open this long after the coil is off
+
+//Foot switch settings
+#define _FOOTSW_DEBOUNCE_MS				30			//Pedal must stay pressed (or released) this long
+
+//Force trigger settings (HX711 load cell)
+#define _FORCE_COUNTS_PER_N				8560		//Load cell counts per Newton (2mV/V, 50kg cell, gain 128)
+#define _FORCE_STABLE_MS				30			//Force must hold steady this long above the setpoint to trigger
+#define _FORCE_BAND_PCT					10			//'Steady' = Within this much of the setpoint
+#define _FORCE_ZERO_PCT					5			//Below this much of the setpoint the zero tracks drift
+#define _FORCE_ZERO_SHIFT				4			//Zero tracking rate (1 >> n of the error per sample)
+#define _FORCE_STALE_MS					50			//No load cell sample for this long (4 at 80/S) - The force reads as not there
+
+//Contact resistance settings (Measured through the measurement relay, contact trigger only)
+#define _CR_MOHM_PER_V					100			//Contact resistance per volt at the sense comparator
+#define _CR_MV_PER_DAC					16			//Threshold DAC step (mV)
+#define _CR_SETTLE_US					50			//Comparator settling time per DAC step
+#define _CR_MAX_mOHM					300			//Refuse to weld above this
+#define _CR_TABLE_LEN					5			//Heat lookup table entries (See WeldCtrl.c)
+
+//Contact trigger auto calibration settings
+#define _TRIGCAL_FRACTION_PCT			50			//Threshold goes this far from the shorted to the open reading
+#define _TRIGCAL_MIN_SPAN				4			//Open and shorted readings must be this many DAC steps apart
+
+//Quality classification settings (Dynamic resistance)
+#define _DR_MIN_A						50			//Current needed to trace the resistance (Below it V/I is mostly noise)
+#define _DR_MIN_BINS					4			//Fewer trace bins than this can't be classified
+#define _DR_COLD_DROP_PCT				5			//Less drop from the peak than this is a cold weld
+#define _DR_EXPULSION_STEP_PCT			20			//A drop this big between two bins is an expulsion
+
+//Expulsion detection settings
+#define _EXPEL_MIN_A					100			//Current needed to watch the electrode voltage (Heating, not just flowing)
+
+//Stitch settings (Repeats while the foot switch is held - Off time sets the rate)
+#define _STITCH_MAX_DUTY_PCT			50			//Weld on time can be at most this much of each stitch (Thermal limit)
+#define _STITCH_MIN_OFF_mS				100			//Shortest off time between stitches
+
 //ZeroX detection settings 
 #define _MAXZeroXLossTime_mS			100
+#define _MAXZeroXWaitIntOff_US			_CC_MAX_HALFCYCLE_US	//Longest wait with interrupts off (One half cycle)
+#define _ZeroXPollIntOff_US				10
+
+//Contact chatter record entry
+typedef struct chatter_s_t
+{
+	uint32_t US;					//Edge time (System uS, 0 = Unused)
+	uint8_t  Made;					//1 = Contact made, 0 = Broken
+}chatter_s_t;
+
+//Measurement relay states
+typedef enum mrelay_e_t
+{
+	MRelay_Open			=	0,
+	MRelay_Closing		=	1,		//Coil on, contacts settling
+	MRelay_Closed		=	2,		//Settled - Contact sensing is valid
+	MRelay_Opening		=	3		//Coil off, contacts releasing
+}mrelay_e_t;
+
+//Foot switch debounce states
+typedef enum footsw_e_t
+{
+	FootSW_Armed		=	0,		//INT1 on, waiting for a press edge
+	FootSW_Press		=	1,		//Press edge seen, INT1 off until it is confirmed
+	FootSW_Held			=	2		//Waiting for a steady release to re-arm
+}footsw_e_t;
+
+//Contact resistance heat lookup (Up to MaxR, scale the heat by Heat %)
+typedef struct crheat_s_t
+{
+	uint16_t MaxR_mOhm;
+	uint16_t Heat;
+}crheat_s_t;
 
 //Weld trigger type enum
 typedef enum weldtrigger_e_t
 {
 	wTrigFootSwitch		=	0,
-	wTrigContact		=	1
+	wTrigContact		=	1,
+	wTrigForce			=	2,
+	wTrigContactFS		=	3,		//Foot switch arms, contact fires
+	wTrigStitch			=	4		//Foot switch, repeats while held
 }weldtrigger_e_t;
 
 //Weld Type Enum
@@ -70,17 +195,26 @@ typedef enum weldtype_e_t
 {
 	wTypeContinuous		=	0,
 	wTypeSinglePulse	=	1,
-	wTypeDoublePulse	=	2
+	wTypeDoublePulse	=	2,
+	wTypeCapDischarge	=	3,
+	wTypeEnergy			=	4,
+	wTypeConstCurrent	=	5
 }weldtype_e_t;
 
 //weld definition Structure 
 typedef struct weldctrl_s_t
 {
 	uint16_t Voltage;
+	uint16_t Energy;
+	uint16_t Current;
+	uint16_t Force;
 	uint16_t P0_Length;
 	uint16_t P1_Length;
 	uint16_t IP_Delay;
 	uint16_t Trig_Delay;
+	uint16_t Squeeze_Time;
+	uint16_t Hold_Time;
+	uint16_t Off_Time;
 	weldtrigger_e_t Trigger;
 	weldtype_e_t Type;
 } weldctrl_s_t;
@@ -102,6 +236,50 @@ uint8_t IsWeldEnabled(void);
 void DisableWeld(void);
 //Enable Weld
 int EnableWeld(void);
+//Get the boot to ready time in uS (0 = Not ready yet)
+uint32_t WELD_GetBootReadyTime(void);
+//Regulate the capacitor bank charge (Called from the system tick ISR)
+void WELD_ChargeTick(void);
+//Debounce the foot switch (Called from the system tick ISR)
+void WELD_FootSwitchTick(void);
+//Sample the load cell and watch for a steady force (Called from the weld service)
+void WELD_ForceTick(void);
+//Get the electrode force (N)
+int16_t WELD_GetForce(void);
+//Get the capacitor bank voltage in mV
+uint16_t WELD_GetCapVoltage(void);
+//Get the charge state: 1 = Charged to the set voltage and ready to fire
+uint8_t WELD_IsCharged(void);
+//Convert Joules to energy integrator units (See ADC_StartEnergy())
+uint32_t WELD_JoulesToEnergy(uint16_t Joules);
+//Get the fault code of the last weld (See weldfault_e_t)
+uint8_t WELD_GetLastFault(void);
+//Close (1) or open (0) the measurement relay; the change is timed by WELD_Service
+void WELD_SetMRelay(uint8_t On);
+//Get the measurement relay state (See mrelay_e_t)
+uint8_t WELD_GetMRelay(void);
+//Get the trigger to fire latency of the last weld (uS, 0xFFFFFFFF = Did not fire)
+uint32_t WELD_GetLastLatency(void);
+//Get the number of contact make/break edges seen (Wraps)
+uint16_t WELD_GetContactEdges(void);
+//Get the bounces in the last touch, and the longest break between them (uS)
+uint8_t WELD_GetChatter(uint32_t* MaxGapUS);
+//Read back a recorded contact edge; Age 0 = Newest.  Returns 1 if valid, 0 if not
+uint8_t WELD_GetChatterEdge(uint8_t Age, chatter_s_t* Edge);
+//Find the electrode voltage as a threshold DAC code (Measurement relay must be on)
+uint8_t WELD_SenseSAR(void);
+//Check the contact capture is idle (Relay closed, no contact or edge waiting).  Returns 1 if idle
+uint8_t WELD_IsContactIdle(void);
+//Get the quality verdict of the last weld (See weldquality_e_t)
+uint8_t WELD_GetLastQuality(void);
+//Get the contact resistance measured for the last weld (mOhm, 0xffff = Open)
+uint16_t WELD_GetContactR(void);
+//Get the heat scale used for the contact resistance (%)
+uint8_t WELD_GetContactHeat(void);
+//Get the RMS line voltage (V)
+uint16_t WELD_GetLineVoltage(void);
+//Get the line compensation applied to the last weld (% of the set pulse length)
+uint8_t WELD_GetLineComp(void);
 //Get Current Weld Settings
 weldctrl_s_t* GetWeldSettings(void);
 
@@ -0,0 +1,225 @@
+//*****************************************************************************
+//
+// File Name	: 'WeldLog.c'
+// Title		: MiniWeld Pro Miniature Spot Welder - Weld event log and counters
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+//Notes:
+//Each weld is recorded in a ring of fixed size records in EEPROM.  The time 
+//of each weld is stored as the delta from the previous weld, and the record 
+//sequence number is used to find the newest record on power up, so no head 
+//pointer has to be written (each slot is only written once per trip around 
+//the ring).  The lifetime counter is spread over several slots for the same
+//reason.  The shift counter is stored as the lifetime count at shift start.
+//
+//All EEPROM writes go through the background writer (EEQueue), so logging 
+//never adds time to the weld cycle.  Records are queued by reference from a
+//few staging copies; a copy is not reused while the writer still has it.  
+//A weld that outruns the writer is counted but its record is dropped (and 
+//the drop counted and traced) rather than holding up the main loop.
+
+#include "SpotWelder.h"
+
+//EEPROM data and Variables
+wlog_rec_s_t EEMEM ee_WELD_LOG[_WLOG_RECORDS];				//Weld log ring
+uint32_t	 EEMEM ee_WELD_COUNT[_WLOG_COUNT_SLOTS];		//Lifetime weld counter
+uint32_t	 EEMEM ee_WELD_SHIFT_START;						//Lifetime count at start of shift
+
+//Log Local Variables *********************************************************
+static uint8_t NextIndex;									//Ring slot for the next record
+static uint8_t NextSeq;										//Sequence number for the next record
+static uint8_t ValidRecords;								//Records in the ring
+
+//Records waiting for the EEPROM writer
+static wlog_rec_s_t Staging[_WLOG_STAGING];
+static uint8_t StageIndex;
+static uint16_t DropCount;
+
+//Counters
+static uint32_t LifetimeCount;
+static uint32_t ShiftStart;
+
+//Weld rate and time between welds
+static uint32_t RateTS[_WLOG_RATE_WELDS];
+static uint8_t RateIndex, RateCount;
+
+//Function implementations ****************************************************
+
+//Log Functions *********
+//Find the newest record and load the counters from EEPROM
+void WLOG_Init(void){
+	
+	uint8_t i, Seq, LastSeq = 0;
+	uint32_t TempVal;
+	
+	//Find the end of the sequence
+	NextIndex = NextSeq = 0;
+	for(i = 0; i < _WLOG_RECORDS; i++){
+		//Empty slot?
+		if(eeprom_read_byte(&ee_WELD_LOG[i].Mode) == 0xff) break;
+		Seq = eeprom_read_byte(&ee_WELD_LOG[i].Seq);
+		//Sequence broken?
+		if((i != 0) && (Seq != (uint8_t)(LastSeq + 1))) break;
+		LastSeq = Seq;
+		NextIndex = i + 1;
+		NextSeq = Seq + 1;
+	}
+	if(NextIndex >= _WLOG_RECORDS) NextIndex = 0;
+	
+	//Has the ring wrapped?
+	if(eeprom_read_byte(&ee_WELD_LOG[NextIndex].Mode) != 0xff)
+		ValidRecords = _WLOG_RECORDS;
+	else
+		ValidRecords = NextIndex;
+	
+	//Load the lifetime count (Highest slot)
+	LifetimeCount = 0;
+	for(i = 0; i < _WLOG_COUNT_SLOTS; i++){
+		TempVal = eeprom_read_dword(&ee_WELD_COUNT[i]);
+		if((TempVal != 0xffffffff) && (TempVal > LifetimeCount)) LifetimeCount = TempVal;
+	}
+	
+	//Load start of shift
+	if( (TempVal = eeprom_read_dword(&ee_WELD_SHIFT_START)) != 0xffffffff)
+		ShiftStart = TempVal;
+	else
+		ShiftStart = 0;
+	
+	//No welds yet
+	RateIndex = RateCount = 0;
+}
+
+//Add a weld to the log and counters (Seq and DeltaT are filled in here)
+void WLOG_Record(wlog_rec_s_t* Rec){
+	
+	uint32_t Now, Delta;
+	wlog_rec_s_t* Stage;
+	
+	Now = GetSysTicks();
+	
+	//Time since last weld
+	if(RateCount){
+		Delta = Now - RateTS[(RateIndex + _WLOG_RATE_WELDS - 1) % _WLOG_RATE_WELDS];
+		if(Delta == _WLOG_DELTA_NONE) Delta--;
+	}else{
+		Delta = _WLOG_DELTA_NONE;
+	}
+	
+	//Save time stamp for weld rate
+	RateTS[RateIndex] = Now;
+	if(++RateIndex >= _WLOG_RATE_WELDS) RateIndex = 0;
+	if(RateCount < _WLOG_RATE_WELDS) RateCount++;
+	
+	//Count it
+	LifetimeCount++;
+	EEQ_UpdateDWord(&ee_WELD_COUNT[LifetimeCount % _WLOG_COUNT_SLOTS], LifetimeCount);
+	
+	//Build the record where the writer can get at it - Drop it if the 
+	//writer still has the last record from this copy
+	Stage = &Staging[StageIndex];
+	if(EEQ_IsQueued(Stage)){
+		if(DropCount < 0xffff) DropCount++;
+		TRACE_Event(TrcEvt_LogDrop, (DropCount > 0xff) ? 0xff : (uint8_t)DropCount);
+		return;
+	}
+	if(++StageIndex >= _WLOG_STAGING) StageIndex = 0;
+	memcpy((void*)Stage, (const void*)Rec, sizeof(wlog_rec_s_t));
+	Stage->Seq = NextSeq++;
+	Stage->DeltaT = Delta;
+	
+	//Queue the record
+	EEQ_UpdateBlock(Stage, &ee_WELD_LOG[NextIndex], sizeof(wlog_rec_s_t));
+	if(++NextIndex >= _WLOG_RECORDS) NextIndex = 0;
+	if(ValidRecords < _WLOG_RECORDS) ValidRecords++;
+}
+
+//Read back a record; Age 0 = Newest.  Returns 1 if valid, 0 if not 
+uint8_t WLOG_GetRecord(uint8_t Age, wlog_rec_s_t* Rec){
+	
+	uint8_t Index;
+	
+	if(Age >= ValidRecords) return 0;
+	
+	//Work back from the newest
+	Index = (NextIndex + _WLOG_RECORDS - 1 - Age) % _WLOG_RECORDS;
+	EEQ_ReadBlock(Rec, &ee_WELD_LOG[Index], sizeof(wlog_rec_s_t));
+	
+	return 1;
+}
+
+//Get the number of records in the log
+uint8_t WLOG_GetRecordCount(void){
+	return ValidRecords;
+}
+
+//Get the number of records dropped because the EEPROM writer was behind
+uint16_t WLOG_GetDropCount(void){
+	return DropCount;
+}
+
+//Counter Functions *********
+//Get the lifetime weld count
+uint32_t WLOG_GetLifetimeCount(void){
+	return LifetimeCount;
+}
+
+//Get the weld count for this shift
+uint32_t WLOG_GetShiftCount(void){
+	return LifetimeCount - ShiftStart;
+}
+
+//Start a new shift (Resets the shift count)
+void WLOG_ResetShift(void){
+	
+	ShiftStart = LifetimeCount;
+	EEQ_UpdateDWord(&ee_WELD_SHIFT_START, ShiftStart);
+}
+
+//Get the current weld rate (Welds per minute)
+uint16_t WLOG_GetRate(void){
+	
+	uint32_t Newest, Oldest;
+	
+	//Need two welds for a rate
+	if(RateCount < 2) return 0;
+	
+	Newest = RateTS[(RateIndex + _WLOG_RATE_WELDS - 1) % _WLOG_RATE_WELDS];
+	Oldest = RateTS[(RateIndex + _WLOG_RATE_WELDS - RateCount) % _WLOG_RATE_WELDS];
+	
+	//Stopped welding?
+	if((GetSysTicks() - Newest) > (_WLOG_RATE_WINDOW_MS / _MS_PER_SYSTICK)) return 0;
+	if(Newest == Oldest) return 0;
+	
+	//Welds per minute over the saved welds (Rounded)
+	return (uint16_t)( ( ((uint32_t)(RateCount - 1) * (60000 / _MS_PER_SYSTICK)) + ((Newest - Oldest) / 2) ) / (Newest - Oldest) );
+}
@@ -0,0 +1,109 @@
+//*****************************************************************************
+//
+// File Name	: 'WeldLog.h'
+// Title		: MiniWeld Pro Miniature Spot Welder - Weld event log and counters
+// Author		: SpotWelder contributors - Copyright (C) 2026
+// Created		: 2026-10-19
+// Revised		:
+// Version		: 1.0
+// Target MCU	: Atmel AVR series
+//
+//*****************************************************************************
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are
+//  met:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of J-Squared nor the
+//    names of its contributors may be used to endorse or promote products
+//    derived from this software without specific prior written permission.
+
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS
+//  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+//  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+//  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+//  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+//  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+//  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+//  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+//  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+//  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+//  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//*****************************************************************************
+
+#ifndef WELDLOG_H_
+#define WELDLOG_H_
+
+#include <avr/io.h>
+
+//Log settings
+#define _WLOG_RECORDS				48			//Records kept in the EEPROM ring
+#define _WLOG_COUNT_SLOTS			16			//Wear levelling slots for the lifetime counter
+#define _WLOG_STAGING				4			//Records that can wait for the EEPROM writer
+#define _WLOG_RATE_WELDS			8			//Welds used to compute the weld rate
+#define _WLOG_RATE_WINDOW_MS		60000		//Rate drops to 0 after this long without a weld
+#define _WLOG_DELTA_NONE			0xFFFFFFFF	//DeltaT value for 'First weld after power up'
+
+//Weld fault code enum
+typedef enum weldfault_e_t
+{
+	wFaultNone			=	0,
+	wFaultZeroX			=	1,		//AC line lost during the weld
+	wFaultHalted		=	2,		//Weld was disabled before it finished
+	wFaultEnergy		=	3,		//Max pulse time was reached before the energy target
+	wFaultMisfire		=	4,		//No weld current when the output was turned on
+	wFaultContactR		=	5		//Contact resistance out of range - Weld refused
+}weldfault_e_t;
+
+//Weld quality enum (From the dynamic resistance)
+typedef enum weldquality_e_t
+{
+	wQualUnknown		=	0,		//Too short to tell, or did not fire
+	wQualGood			=	1,		//Resistance peaked then dropped as the nugget formed
+	wQualCold			=	2,		//Resistance never dropped - No nugget
+	wQualExpulsion		=	3		//Resistance collapsed suddenly - Metal was expelled
+}weldquality_e_t;
+
+//Weld log record (As stored in EEPROM)
+typedef struct wlog_rec_s_t
+{
+	uint8_t  Seq;					//Sequence number - finds the newest record
+	uint8_t  Mode;					//Weld type (Low nibble) and Trigger type (High nibble)
+	uint8_t  Fault;					//Fault code (See weldfault_e_t)
+	uint8_t  Aux;					//Mode specific - Energy: % of target delivered, Const Current: Last current (A / 10)
+	uint32_t DeltaT;				//Time since the previous weld (System ticks, full 32 bit delta)
+	uint8_t  P0;					//Pulse 0 Length (Weld ticks)
+	uint8_t  P1;					//Pulse 1 Length (Weld ticks)
+	uint16_t Latency;				//Trigger to fire latency (0.1mS)
+	uint8_t  Line;					//RMS line voltage at fire time (V)
+	uint8_t  Comp;					//Line compensation (% of the set pulse length, 100 = None)
+	uint8_t  Quality;				//Quality verdict (See weldquality_e_t)
+	uint8_t  RDrop;					//Dynamic resistance drop, peak to end (% of peak)
+} wlog_rec_s_t;
+
+//Log Functions *********
+//Find the newest record and load the counters from EEPROM
+void WLOG_Init(void);
+//Add a weld to the log and counters (Seq and DeltaT are filled in here)
+void WLOG_Record(wlog_rec_s_t* Rec);
+//Read back a record; Age 0 = Newest.  Returns 1 if valid, 0 if not 
+uint8_t WLOG_GetRecord(uint8_t Age, wlog_rec_s_t* Rec);
+//Get the number of records in the log
+uint8_t WLOG_GetRecordCount(void);
+//Get the number of records dropped because the EEPROM writer was behind
+uint16_t WLOG_GetDropCount(void);
+
+//Counter Functions *********
+//Get the lifetime weld count
+uint32_t WLOG_GetLifetimeCount(void);
+//Get the weld count for this shift
+uint32_t WLOG_GetShiftCount(void);
+//Start a new shift (Resets the shift count)
+void WLOG_ResetShift(void);
+//Get the current weld rate (Welds per minute)
+uint16_t WLOG_GetRate(void);
+
+#endif /* WELDLOG_H_ */